@@ -4,10 +4,15 @@
 
 #include <stdio.h>
 
+#include <fstream>
+#include <iostream>
+
 #include "device/device.h"
 #include "scene/camera.h"
 #include "scene/integrator.h"
+#include "scene/pass.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "session/session.h"
 
@@ -48,7 +53,10 @@ struct Options {
   bool quiet;
   bool show_help, interactive, pause;
   string output_filepath;
-  string output_pass;
+  string output_passes;
+  vector<string> full_buffer_files;
+  string profile_json_filepath;
+  string batch_filepath;
 } options;
 
 static void session_print(const string &str)
@@ -95,6 +103,22 @@ static BufferParams &session_buffer_params()
   return buffer_params;
 }
 
+static void scene_camera_update()
+{
+  /* Camera width/height override? */
+  if (!(options.width == 0 || options.height == 0)) {
+    options.scene->camera->set_full_width(options.width);
+    options.scene->camera->set_full_height(options.height);
+  }
+  else {
+    options.width = options.scene->camera->get_full_width();
+    options.height = options.scene->camera->get_full_height();
+  }
+
+  /* Calculate Viewplane */
+  options.scene->camera->compute_auto_viewplane();
+}
+
 static void scene_init()
 {
   options.scene = options.session->scene;
@@ -110,23 +134,23 @@ static void scene_init()
     xml_read_file(options.scene, options.filepath.c_str());
   }
 
-  /* Camera width/height override? */
-  if (!(options.width == 0 || options.height == 0)) {
-    options.scene->camera->set_full_width(options.width);
-    options.scene->camera->set_full_height(options.height);
-  }
-  else {
-    options.width = options.scene->camera->get_full_width();
-    options.height = options.scene->camera->get_full_height();
-  }
+  scene_camera_update();
+}
 
-  /* Calculate Viewplane */
-  options.scene->camera->compute_auto_viewplane();
+static vector<string> session_output_passes()
+{
+  vector<string> output_passes;
+  string_split(output_passes, options.output_passes, ",");
+  if (output_passes.empty()) {
+    output_passes.push_back("combined");
+  }
+  return output_passes;
 }
 
 static void session_init()
 {
-  options.output_pass = "combined";
+  const vector<string> output_passes = session_output_passes();
+
   options.session = new Session(options.session_params, options.scene_params);
 
 #ifdef WITH_CYCLES_STANDALONE_GUI
@@ -137,10 +161,16 @@ static void session_init()
 #endif
 
   if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+    options.session->set_output_driver(
+        make_unique<OIIOOutputDriver>(options.output_filepath, output_passes, session_print));
   }
 
+  /* With tiled rendering the result is written to disk during rendering, and is processed and
+   * written to the output once rendering is finished. */
+  options.session->full_buffer_written_cb = [](string_view filename) {
+    options.full_buffer_files.emplace_back(filename);
+  };
+
   if (options.session_params.background && !options.quiet)
     options.session->progress.set_update_callback(function_bind(&session_print_status));
 #ifdef WITH_CYCLES_STANDALONE_GUI
@@ -151,18 +181,136 @@ static void session_init()
   /* load scene */
   scene_init();
 
-  /* add pass for output. */
-  Pass *pass = options.scene->create_node<Pass>();
-  pass->set_name(ustring(options.output_pass.c_str()));
-  pass->set_type(PASS_COMBINED);
+  /* add passes for output. */
+  const NodeEnum *pass_type_enum = Pass::get_type_enum();
+  for (const string &output_pass : output_passes) {
+    const ustring pass_name(output_pass);
+    if (!pass_type_enum->exists(pass_name)) {
+      fprintf(stderr, "Unknown pass: %s\n", output_pass.c_str());
+      continue;
+    }
+
+    Pass *pass = options.scene->create_node<Pass>();
+    pass->set_name(pass_name);
+    pass->set_type(static_cast<PassType>((*pass_type_enum)[pass_name]));
+  }
+
+  options.session->reset(options.session_params, session_buffer_params());
+  options.session->start();
+}
+
+static void session_write_profile_json()
+{
+  RenderStats stats;
+  options.session->collect_statistics(&stats);
+
+  FILE *file = path_fopen(options.profile_json_filepath, "w");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to write profile to %s\n", options.profile_json_filepath.c_str());
+    return;
+  }
+
+  const string report = stats.json_report();
+  fwrite(report.data(), 1, report.size(), file);
+  fclose(file);
+}
+
+static void session_process_full_buffer_files()
+{
+  for (const string &filename : options.full_buffer_files) {
+    options.session->process_full_buffer_from_disk(filename);
+    path_remove(filename);
+  }
+  options.full_buffer_files.clear();
+}
+
+/* Render a single batch job. The scene delta is read on top of the scene which is already loaded,
+ * so the device, images and geometry which the delta does not touch stay resident and only the
+ * modified data is synchronized to the device. */
+static bool session_batch_job(const string &delta_filepath, const string &output_filepath)
+{
+  if (!path_exists(delta_filepath)) {
+    fprintf(stderr, "Batch job scene delta not found: %s\n", delta_filepath.c_str());
+    return false;
+  }
+
+  /* Results of the previous job are written before its output driver is replaced. */
+  session_process_full_buffer_files();
+
+  /* A job without output path is rendered without writing a file, it must not overwrite the
+   * output of the previous job. */
+  if (output_filepath.empty()) {
+    options.session->set_output_driver(nullptr);
+  }
+  else {
+    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
+        output_filepath, session_output_passes(), session_print));
+  }
+
+  {
+    thread_scoped_lock scene_lock(options.scene->mutex);
+    xml_read_file(options.scene, delta_filepath.c_str());
+    scene_camera_update();
+  }
 
   options.session->reset(options.session_params, session_buffer_params());
   options.session->start();
+  options.session->wait();
+
+  return !options.session->progress.get_cancel();
+}
+
+/* Render jobs listed in the batch file, or streamed through the standard input when the file path
+ * is "-". Every non-empty line which does not start with '#' describes one job as a path to the
+ * scene delta XML file, optionally followed by the output file path. */
+static void session_batch()
+{
+  std::ifstream batch_file;
+  const bool use_stdin = (options.batch_filepath == "-");
+  if (!use_stdin) {
+    batch_file.open(options.batch_filepath);
+    if (!batch_file.is_open()) {
+      fprintf(stderr, "Failed to open batch file %s\n", options.batch_filepath.c_str());
+      return;
+    }
+  }
+  std::istream &stream = (use_stdin) ? std::cin : batch_file;
+
+  int num_jobs = 0;
+  string line;
+  while (std::getline(stream, line)) {
+    vector<string> tokens;
+    string_split(tokens, line);
+    if (tokens.empty() || string_startswith(tokens[0], "#")) {
+      continue;
+    }
+    if (tokens.size() > 2) {
+      fprintf(stderr, "Ignoring malformed batch job: %s\n", line.c_str());
+      continue;
+    }
+
+    const string output_filepath = (tokens.size() == 2) ? tokens[1] : "";
+    if (!session_batch_job(tokens[0], output_filepath)) {
+      break;
+    }
+
+    num_jobs++;
+    if (!options.quiet) {
+      session_print(string_printf("Finished batch job %d: %s", num_jobs, tokens[0].c_str()));
+      printf("\n");
+    }
+  }
 }
 
 static void session_exit()
 {
   if (options.session) {
+    if (!options.profile_json_filepath.empty()) {
+      session_write_profile_json();
+    }
+
+    session_process_full_buffer_files();
+
     delete options.session;
     options.session = NULL;
   }
@@ -421,12 +569,28 @@ static void options_parse(int argc, const char **argv)
              "--tile-size %d",
              &options.session_params.tile_size,
              "Tile size in pixels",
+             "--full-frame-tile-size %d",
+             &options.session_params.full_frame_tile_size,
+             "Size of tiles in pixels in which the result of tiled rendering is denoised and "
+             "written, limiting memory usage of huge resolutions",
+             "--output-passes %s",
+             &options.output_passes,
+             "Comma separated list of passes to write to the output image (default: combined)",
              "--list-devices",
              &list,
              "List information about all available devices",
              "--profile",
              &profile,
              "Enable profile logging",
+             "--profile-json %s",
+             &options.profile_json_filepath,
+             "Enable profiling and write render statistics to the given JSON file",
+             "--batch %s",
+             &options.batch_filepath,
+             "After rendering the scene, render jobs listed one per line in the given file as "
+             "'delta.xml [output]', or read from standard input when the file is '-'. Each scene "
+             "delta is applied on top of the loaded scene, keeping the device, images and "
+             "unchanged geometry resident between jobs",
 #ifdef WITH_CYCLES_LOGGING
              "--debug",
              &debug,
@@ -476,7 +640,7 @@ static void options_parse(int argc, const char **argv)
     exit(EXIT_SUCCESS);
   }
 
-  options.session_params.use_profiling = profile;
+  options.session_params.use_profiling = profile || !options.profile_json_filepath.empty();
 
   if (ssname == "osl")
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -491,6 +655,11 @@ static void options_parse(int argc, const char **argv)
     options.session_params.use_auto_tile = true;
   }
 
+  if (!options.batch_filepath.empty() && !options.session_params.background) {
+    fprintf(stderr, "Batch rendering is only supported in background mode\n");
+    exit(EXIT_FAILURE);
+  }
+
   /* find matching device */
   DeviceType device_type = Device::type_from_string(devicename.c_str());
   vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK(device_type));
@@ -543,6 +712,9 @@ int main(int argc, const char **argv)
 #endif
     session_init();
     options.session->wait();
+    if (!options.batch_filepath.empty()) {
+      session_batch();
+    }
     session_exit();
 #ifdef WITH_CYCLES_STANDALONE_GUI
   }
@@ -5,28 +5,137 @@
 #include "app/oiio_output_driver.h"
 
 #include "scene/colorspace.h"
+#include "session/tile.h"
 
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
 
 CCL_NAMESPACE_BEGIN
 
+/* Number of channels written for every pass. */
+static const int PASS_NUM_CHANNELS = 4;
+
+/* Apply gamma correction for (some) non-linear file formats, in place.
+ * TODO: use OpenColorIO view transform if available. */
+static void apply_output_gamma(ImageOutput *image_output,
+                               ImageBuf &image_buffer,
+                               const int num_passes)
+{
+  if (ColorSpaceManager::detect_known_colorspace(
+          u_colorspace_auto, "", image_output->format_name(), true) != u_colorspace_srgb)
+  {
+    return;
+  }
+
+  const float g = 1.0f / 2.2f;
+  vector<float> gamma;
+  for (int i = 0; i < num_passes; ++i) {
+    gamma.insert(gamma.end(), {g, g, g, 1.0f});
+  }
+  ImageBufAlgo::pow(image_buffer, image_buffer, gamma);
+}
+
+/* Write pixels of the full frame to the opened image output, and close it. */
+static void write_image_pixels(ImageOutput *image_output,
+                               const ImageSpec &spec,
+                               const int num_passes,
+                               float *pixels)
+{
+  ImageBuf image_buffer(spec, pixels);
+
+  apply_output_gamma(image_output, image_buffer, num_passes);
+
+  /* Write to disk and close */
+  image_buffer.set_write_format(TypeDesc::FLOAT);
+  image_buffer.write(image_output);
+  image_output->close();
+}
+
 OIIOOutputDriver::OIIOOutputDriver(const string_view filepath,
-                                   const string_view pass,
+                                   const vector<string> &passes,
                                    LogFunction log)
-    : filepath_(filepath), pass_(pass), log_(log)
+    : filepath_(filepath), passes_(passes), log_(log)
 {
 }
 
-OIIOOutputDriver::~OIIOOutputDriver() {}
+OIIOOutputDriver::~OIIOOutputDriver()
+{
+  close_tiled_output();
+}
 
 void OIIOOutputDriver::write_render_tile(const Tile &tile)
 {
-  /* Only write the full buffer, no intermediate tiles. */
-  if (!(tile.size == tile.full_size)) {
-    return;
+  if (tile.size == tile.full_size) {
+    write_full_frame(tile);
   }
+  else {
+    write_partial_tile(tile);
+  }
+}
 
+ImageSpec OIIOOutputDriver::image_spec(const int width, const int height) const
+{
+  static const char *component_suffixes[] = {"R", "G", "B", "A"};
+
+  const int num_passes = passes_.size();
+
+  ImageSpec spec(width, height, num_passes * PASS_NUM_CHANNELS, TypeDesc::FLOAT);
+
+  /* Keep the default RGBA channel names when there is a single pass, so that the image can be
+   * viewed as-is. */
+  if (num_passes > 1) {
+    spec.channelnames.clear();
+    for (const string &pass : passes_) {
+      for (int i = 0; i < PASS_NUM_CHANNELS; ++i) {
+        spec.channelnames.push_back(pass + "." + component_suffixes[i]);
+      }
+    }
+  }
+
+  return spec;
+}
+
+bool OIIOOutputDriver::read_tile_pixels(const Tile &tile,
+                                        const int num_padding_rows,
+                                        vector<float> &pixels)
+{
+  const int64_t width = tile.size.x;
+  const int64_t height = tile.size.y;
+  const int64_t num_passes = passes_.size();
+  const int64_t pixel_stride = num_passes * PASS_NUM_CHANNELS;
+
+  pixels.clear();
+  pixels.resize(width * (height + num_padding_rows) * pixel_stride, 0.0f);
+
+  vector<float> pass_pixels(width * height * PASS_NUM_CHANNELS);
+
+  for (int64_t pass_index = 0; pass_index < num_passes; ++pass_index) {
+    if (!tile.get_pass_pixels(passes_[pass_index], PASS_NUM_CHANNELS, pass_pixels.data())) {
+      log_("Failed to read render pass pixels of " + passes_[pass_index]);
+      return false;
+    }
+
+    /* Interleave the pass into the image pixels, converting from bottom-up to top-down
+     * convention. */
+    for (int64_t y = 0; y < height; ++y) {
+      const float *src = pass_pixels.data() + (height - 1 - y) * width * PASS_NUM_CHANNELS;
+      float *dst = pixels.data() + ((y + num_padding_rows) * width) * pixel_stride +
+                   pass_index * PASS_NUM_CHANNELS;
+      for (int64_t x = 0; x < width; ++x) {
+        for (int i = 0; i < PASS_NUM_CHANNELS; ++i) {
+          dst[i] = src[i];
+        }
+        src += PASS_NUM_CHANNELS;
+        dst += pixel_stride;
+      }
+    }
+  }
+
+  return true;
+}
+
+void OIIOOutputDriver::write_full_frame(const Tile &tile)
+{
   log_(string_printf("Writing image %s", filepath_.c_str()));
 
   unique_ptr<ImageOutput> image_output(ImageOutput::create(filepath_));
@@ -35,41 +144,162 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
     return;
   }
 
-  const int width = tile.size.x;
-  const int height = tile.size.y;
-
-  ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
+  const ImageSpec spec = image_spec(tile.size.x, tile.size.y);
   if (!image_output->open(filepath_, spec)) {
     log_("Failed to create image file");
     return;
   }
 
-  vector<float> pixels(width * height * 4);
-  if (!tile.get_pass_pixels(pass_, 4, pixels.data())) {
-    log_("Failed to read render pass pixels");
+  vector<float> pixels;
+  if (!read_tile_pixels(tile, 0, pixels)) {
     return;
   }
 
-  /* Manipulate offset and stride to convert from bottom-up to top-down convention. */
-  ImageBuf image_buffer(spec,
-                        pixels.data() + (height - 1) * width * 4,
-                        AutoStride,
-                        -width * 4 * sizeof(float),
-                        AutoStride);
+  write_image_pixels(image_output.get(), spec, passes_.size(), pixels.data());
+}
 
-  /* Apply gamma correction for (some) non-linear file formats.
-   * TODO: use OpenColorIO view transform if available. */
-  if (ColorSpaceManager::detect_known_colorspace(
-          u_colorspace_auto, "", image_output->format_name(), true) == u_colorspace_srgb)
-  {
-    const float g = 1.0f / 2.2f;
-    ImageBufAlgo::pow(image_buffer, image_buffer, {g, g, g, 1.0f});
+bool OIIOOutputDriver::open_tiled_output(const Tile &tile)
+{
+  const int width = tile.full_size.x;
+  const int height = tile.full_size.y;
+
+  tiled_state_.num_pixels_written = 0;
+
+  unique_ptr<ImageOutput> image_output(ImageOutput::create(filepath_));
+  if (image_output == nullptr) {
+    log_("Failed to create image file");
+    return false;
   }
 
-  /* Write to disk and close */
-  image_buffer.set_write_format(TypeDesc::FLOAT);
-  image_buffer.write(image_output.get());
-  image_output->close();
+  if (!image_output->supports("tiles")) {
+    /* Gather the frame in memory, it will be written once it is complete. */
+    tiled_state_.pixels.resize(int64_t(width) * height * passes_.size() * PASS_NUM_CHANNELS);
+    return true;
+  }
+
+  /* Render tiles are aligned to the image tile size from the bottom of the frame, while the files
+   * are stored top-down. Grow the data window above the frame, so that the image tiles align with
+   * the render tiles. The display window stays the size of the frame. */
+  const int tile_size = TileManager::IMAGE_TILE_SIZE;
+  const int num_padding_rows = align_up(height, tile_size) - height;
+
+  ImageSpec spec = image_spec(width, height + num_padding_rows);
+  spec.y = -num_padding_rows;
+  spec.full_x = 0;
+  spec.full_y = 0;
+  spec.full_width = width;
+  spec.full_height = height;
+  spec.tile_width = tile_size;
+  spec.tile_height = tile_size;
+
+  if (!image_output->open(filepath_, spec)) {
+    log_("Failed to create image file");
+    return false;
+  }
+
+  log_(string_printf("Writing image %s in tiles", filepath_.c_str()));
+
+  tiled_state_.output = std::move(image_output);
+  tiled_state_.num_padding_rows = num_padding_rows;
+
+  return true;
+}
+
+void OIIOOutputDriver::close_tiled_output()
+{
+  if (tiled_state_.output) {
+    tiled_state_.output->close();
+    tiled_state_.output = nullptr;
+  }
+
+  tiled_state_.num_padding_rows = 0;
+  tiled_state_.pixels.clear();
+  tiled_state_.pixels.shrink_to_fit();
+  tiled_state_.num_pixels_written = 0;
+}
+
+void OIIOOutputDriver::write_partial_tile(const Tile &tile)
+{
+  if (!tiled_state_.output && tiled_state_.pixels.empty()) {
+    if (!open_tiled_output(tile)) {
+      return;
+    }
+  }
+
+  const int width = tile.full_size.x;
+  const int height = tile.full_size.y;
+
+  /* Position of the tile in the top-down file convention. */
+  const int x_begin = tile.offset.x;
+  const int x_end = tile.offset.x + tile.size.x;
+  const int y_begin = height - (tile.offset.y + tile.size.y);
+  const int y_end = height - tile.offset.y;
+
+  if (tiled_state_.output) {
+    /* The tile touching the top of the frame also covers the padding rows of the data window. */
+    const int num_padding_rows = (y_begin == 0) ? tiled_state_.num_padding_rows : 0;
+
+    vector<float> pixels;
+    if (!read_tile_pixels(tile, num_padding_rows, pixels)) {
+      return;
+    }
+
+    /* Same color space conversion as for frames which are written in one piece. */
+    const ImageSpec tile_spec = image_spec(tile.size.x, tile.size.y + num_padding_rows);
+    ImageBuf tile_buffer(tile_spec, pixels.data());
+    apply_output_gamma(tiled_state_.output.get(), tile_buffer, passes_.size());
+
+    if (!tiled_state_.output->write_tiles(x_begin,
+                                          x_end,
+                                          y_begin - num_padding_rows,
+                                          y_end,
+                                          0,
+                                          1,
+                                          TypeDesc::FLOAT,
+                                          pixels.data()))
+    {
+      log_("Failed to write image tile: " + tiled_state_.output->geterror());
+      return;
+    }
+  }
+  else {
+    vector<float> pixels;
+    if (!read_tile_pixels(tile, 0, pixels)) {
+      return;
+    }
+
+    const int64_t pixel_stride = passes_.size() * PASS_NUM_CHANNELS;
+    const int64_t row_size = int64_t(tile.size.x) * pixel_stride;
+    for (int y = y_begin; y < y_end; ++y) {
+      memcpy(tiled_state_.pixels.data() + (int64_t(y) * width + x_begin) * pixel_stride,
+             pixels.data() + (y - y_begin) * row_size,
+             sizeof(float) * row_size);
+    }
+  }
+
+  tiled_state_.num_pixels_written += int64_t(tile.size.x) * tile.size.y;
+  if (tiled_state_.num_pixels_written < int64_t(width) * height) {
+    return;
+  }
+
+  /* All tiles of the frame are written. */
+  if (tiled_state_.output) {
+    log_(string_printf("Finished writing image %s", filepath_.c_str()));
+  }
+  else {
+    log_(string_printf("Writing image %s", filepath_.c_str()));
+
+    unique_ptr<ImageOutput> image_output(ImageOutput::create(filepath_));
+    const ImageSpec spec = image_spec(width, height);
+    if (image_output && image_output->open(filepath_, spec)) {
+      write_image_pixels(image_output.get(), spec, passes_.size(), tiled_state_.pixels.data());
+    }
+    else {
+      log_("Failed to create image file");
+    }
+  }
+
+  close_tiled_output();
 }
 
 CCL_NAMESPACE_END
@@ -16,15 +16,50 @@ class OIIOOutputDriver : public OutputDriver {
  public:
   typedef function<void(const string &)> LogFunction;
 
-  OIIOOutputDriver(const string_view filepath, const string_view pass, LogFunction log);
+  /* All given passes are written into the same image, using the pass name as a layer name of the
+   * channels when there is more than one pass. */
+  OIIOOutputDriver(const string_view filepath, const vector<string> &passes, LogFunction log);
   virtual ~OIIOOutputDriver();
 
   void write_render_tile(const Tile &tile) override;
 
  protected:
+  /* Write the tile which covers the full frame. */
+  void write_full_frame(const Tile &tile);
+
+  /* Append tile of a frame which is delivered in multiple tiles.
+   *
+   * For file formats which support tiles the tile is written to the file straight away, so that
+   * the full frame is never kept in memory. Otherwise the frame is gathered in memory and written
+   * once all of its pixels are known. */
+  void write_partial_tile(const Tile &tile);
+
+  bool open_tiled_output(const Tile &tile);
+  void close_tiled_output();
+
+  ImageSpec image_spec(const int width, const int height) const;
+
+  /* Read pixels of all passes of the tile, interleaved and flipped to the top-down order of the
+   * image files. The destination has `num_padding_rows` of zero pixels on top of the tile. */
+  bool read_tile_pixels(const Tile &tile, const int num_padding_rows, vector<float> &pixels);
+
   string filepath_;
-  string pass_;
+  vector<string> passes_;
   LogFunction log_;
+
+  /* State of the file which receives the frame tile by tile. */
+  struct {
+    unique_ptr<ImageOutput> output;
+
+    /* Number of rows above the frame which are added to the data window, so that the image tiles
+     * are aligned with the render tiles which are counted from the bottom of the frame. */
+    int num_padding_rows = 0;
+
+    /* Pixels of the frame, used when the file format does not support tiled writing. */
+    vector<float> pixels;
+
+    int64_t num_pixels_written = 0;
+  } tiled_state_;
 };
 
 CCL_NAMESPACE_END
@@ -368,6 +368,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_denoising_input_passes,
         default='RGB_ALBEDO_NORMAL',
     )
+    denoising_max_memory: IntProperty(
+        name="Denoising Max Memory",
+        description="Maximum amount of memory in megabytes used by OpenImageDenoise, large images "
+        "are denoised in tiles to stay within the limit (0 for no limit)",
+        min=0, max=(1 << 20),
+        default=0,
+    )
 
     use_preview_denoising: BoolProperty(
         name="Use Viewport Denoising",
@@ -430,6 +437,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         step=100.0,
         unit='TIME_ABSOLUTE',
     )
+    use_time_budget: BoolProperty(
+        name="Time Budget",
+        description="Use the time limit to reach a uniform noise level with adaptive sampling. "
+        "Noise is reduced progressively across the image, and sampling may continue past the "
+        "maximum samples while time remains",
+        default=False,
+    )
 
     sampling_pattern: EnumProperty(
         name="Sampling Pattern",
@@ -1462,6 +1476,13 @@ class CyclesCurveRenderSettings(bpy.types.PropertyGroup):
         min=0, max=24,
         default=2,
     )
+    use_compact_storage: BoolProperty(
+        name="Compact Storage",
+        description="Store curve control points on the device with reduced precision, using less memory. "
+        "Useful for scenes with many hair curves, at the cost of small positional inaccuracies. "
+        "Only used with the BVH2 acceleration structure, Embree and GPU ray tracing always use full precision",
+        default=False,
+    )
 
     @classmethod
     def register(cls):
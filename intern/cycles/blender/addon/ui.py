@@ -263,6 +263,9 @@ class CYCLES_RENDER_PT_sampling_render(CyclesButtonsPanel, Panel):
         else:
             col.prop(cscene, "samples", text="Samples")
         col.prop(cscene, "time_limit")
+        sub = col.column()
+        sub.active = cscene.use_adaptive_sampling and cscene.time_limit > 0.0
+        sub.prop(cscene, "use_time_budget")
 
 
 class CYCLES_RENDER_PT_sampling_render_denoise(CyclesButtonsPanel, Panel):
@@ -290,6 +293,7 @@ class CYCLES_RENDER_PT_sampling_render_denoise(CyclesButtonsPanel, Panel):
         col.prop(cscene, "denoising_input_passes", text="Passes")
         if cscene.denoiser == 'OPENIMAGEDENOISE':
             col.prop(cscene, "denoising_prefilter", text="Prefilter")
+            col.prop(cscene, "denoising_max_memory", text="Max Memory")
 
 
 class CYCLES_RENDER_PT_sampling_path_guiding(CyclesButtonsPanel, Panel):
@@ -475,6 +479,7 @@ class CYCLES_RENDER_PT_curves(CyclesButtonsPanel, Panel):
         col.prop(ccscene, "shape", text="Shape")
         if ccscene.shape == 'RIBBONS':
             col.prop(ccscene, "subdivisions", text="Curve Subdivisions")
+        col.prop(ccscene, "use_compact_storage")
 
 
 class CYCLES_RENDER_PT_curves_viewport_display(CyclesButtonsPanel, Panel):
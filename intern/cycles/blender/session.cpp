@@ -639,6 +639,11 @@ static bool bake_setup_pass(Scene *scene, const string &bake_type, const int bak
     return false;
   }
 
+  /* Remove the pass of a previous bake, the session is reused for all images and objects baked
+   * by a bake job. */
+  set<Pass *> clear_passes(scene->passes.begin(), scene->passes.end());
+  scene->delete_nodes(clear_passes);
+
   /* Create pass. */
   Pass *pass = scene->create_node<Pass>();
   pass->set_name(ustring("Combined"));
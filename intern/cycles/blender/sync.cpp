@@ -471,6 +471,7 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
     integrator->set_use_denoise_pass_albedo(denoise_params.use_pass_albedo);
     integrator->set_use_denoise_pass_normal(denoise_params.use_pass_normal);
     integrator->set_denoiser_prefilter(denoise_params.prefilter);
+    integrator->set_denoise_max_memory(denoise_params.max_memory);
   }
 
   /* UPDATE_NONE as we don't want to tag the integrator as modified (this was done by the
@@ -813,6 +814,7 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
   params.hair_subdivisions = get_int(csscene, "subdivisions");
   params.hair_shape = (CurveShapeType)get_enum(
       csscene, "shape", CURVE_NUM_SHAPE_TYPES, CURVE_THICK);
+  params.use_compact_curves = get_boolean(csscene, "use_compact_storage");
 
   int texture_limit;
   if (background) {
@@ -912,6 +914,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   /* Time limit. */
   if (background) {
     params.time_limit = (double)get_float(cscene, "time_limit");
+    params.use_time_budget = get_boolean(cscene, "use_time_budget");
   }
   else {
     /* For the viewport it kind of makes more sense to think in terms of the noise floor, which is
@@ -959,6 +962,7 @@ DenoiseParams BlenderSync::get_denoise_params(BL::Scene &b_scene,
     denoising.type = (DenoiserType)get_enum(cscene, "denoiser", DENOISER_NUM, DENOISER_NONE);
     denoising.prefilter = (DenoiserPrefilter)get_enum(
         cscene, "denoising_prefilter", DENOISER_PREFILTER_NUM, DENOISER_PREFILTER_NONE);
+    denoising.max_memory = get_int(cscene, "denoising_max_memory");
 
     input_passes = (DenoiserInput)get_enum(
         cscene, "denoising_input_passes", DENOISER_INPUT_NUM, DENOISER_INPUT_RGB_ALBEDO_NORMAL);
@@ -47,6 +47,8 @@ BVHBuild::BVHBuild(const vector<Object *> &objects_,
       params(params_),
       progress(progress_),
       progress_start_time(0.0),
+      num_motion_references(0),
+      num_motion_segments(0),
       unaligned_heuristic(objects_)
 {
   spatial_min_overlap = 0.0f;
@@ -56,6 +58,74 @@ BVHBuild::~BVHBuild() {}
 
 /* Adding References */
 
+/* Add references for a motion primitive whose bounds at every BVH time step have been stored in
+ * motion_step_bounds. Neighbor time segments are merged into a single reference as long as the
+ * surface area of the merged bounds, weighted by the time it covers, does not exceed the sum of
+ * the individual segments by more than the merge tolerance. This avoids spending references on
+ * primitives which barely move during (part of) the shutter time. */
+void BVHBuild::add_reference_motion_steps(BoundBox &root,
+                                          BoundBox &center,
+                                          const int num_bvh_steps,
+                                          const int prim_index,
+                                          const int object_index,
+                                          const int prim_type)
+{
+  const float num_bvh_steps_inv_1 = 1.0f / (num_bvh_steps - 1);
+  const int num_segments = num_bvh_steps - 1;
+  const float tolerance = params.motion_step_merge_tolerance;
+
+  auto add_segment = [&](const BoundBox &bounds, const int start_step, const int end_step) {
+    const float prev_time = (float)start_step * num_bvh_steps_inv_1;
+    const float curr_time = (float)end_step * num_bvh_steps_inv_1;
+    references.push_back(
+        BVHReference(bounds, prim_index, object_index, prim_type, prev_time, curr_time));
+    root.grow(bounds);
+    center.grow(bounds.center2());
+    num_motion_references++;
+  };
+
+  /* Segment which is currently being grown, start_step < 0 means there is none. */
+  BoundBox bounds = BoundBox::empty;
+  int start_step = -1;
+  float split_cost = 0.0f;
+
+  for (int segment = 0; segment < num_segments; segment++) {
+    BoundBox segment_bounds = motion_step_bounds[segment];
+    segment_bounds.grow(motion_step_bounds[segment + 1]);
+
+    if (!segment_bounds.valid()) {
+      if (start_step >= 0) {
+        add_segment(bounds, start_step, segment);
+        start_step = -1;
+      }
+      continue;
+    }
+
+    num_motion_segments++;
+
+    const float segment_cost = segment_bounds.safe_area();
+    if (start_step >= 0) {
+      BoundBox merged_bounds = bounds;
+      merged_bounds.grow(segment_bounds);
+      const float merged_cost = merged_bounds.safe_area() * (segment + 1 - start_step);
+      if (tolerance > 0.0f && merged_cost <= tolerance * (split_cost + segment_cost)) {
+        bounds = merged_bounds;
+        split_cost += segment_cost;
+        continue;
+      }
+      add_segment(bounds, start_step, segment);
+    }
+
+    bounds = segment_bounds;
+    start_step = segment;
+    split_cost = segment_cost;
+  }
+
+  if (start_step >= 0) {
+    add_segment(bounds, start_step, num_segments);
+  }
+}
+
 void BVHBuild::add_reference_triangles(BoundBox &root,
                                        BoundBox &center,
                                        Mesh *mesh,
@@ -109,39 +179,20 @@ void BVHBuild::add_reference_triangles(BoundBox &root,
       const size_t num_verts = mesh->verts.size();
       const size_t num_steps = mesh->motion_steps;
       const float3 *vert_steps = attr_mP->data_float3();
-      /* Calculate bounding box of the previous time step.
-       * Will be reused later to avoid duplicated work on
-       * calculating BVH time step boundbox.
+      /* Calculate bounding box of the primitive at every BVH time step,
+       * segments between them are created (and possibly merged) below.
        */
-      float3 prev_verts[3];
-      t.motion_verts(verts, vert_steps, num_verts, num_steps, 0.0f, prev_verts);
-      BoundBox prev_bounds = BoundBox::empty;
-      prev_bounds.grow(prev_verts[0]);
-      prev_bounds.grow(prev_verts[1]);
-      prev_bounds.grow(prev_verts[2]);
-      /* Create all primitive time steps, */
-      for (int bvh_step = 1; bvh_step < num_bvh_steps; ++bvh_step) {
+      for (int bvh_step = 0; bvh_step < num_bvh_steps; ++bvh_step) {
         const float curr_time = (float)(bvh_step)*num_bvh_steps_inv_1;
         float3 curr_verts[3];
         t.motion_verts(verts, vert_steps, num_verts, num_steps, curr_time, curr_verts);
-        BoundBox curr_bounds = BoundBox::empty;
+        BoundBox &curr_bounds = motion_step_bounds[bvh_step];
+        curr_bounds = BoundBox::empty;
         curr_bounds.grow(curr_verts[0]);
         curr_bounds.grow(curr_verts[1]);
         curr_bounds.grow(curr_verts[2]);
-        BoundBox bounds = prev_bounds;
-        bounds.grow(curr_bounds);
-        if (bounds.valid()) {
-          const float prev_time = (float)(bvh_step - 1) * num_bvh_steps_inv_1;
-          references.push_back(
-              BVHReference(bounds, j, object_index, primitive_type, prev_time, curr_time));
-          root.grow(bounds);
-          center.grow(bounds.center2());
-        }
-        /* Current time boundbox becomes previous one for the
-         * next time step.
-         */
-        prev_bounds = curr_bounds;
       }
+      add_reference_motion_steps(root, center, num_bvh_steps, j, object_index, primitive_type);
     }
   }
 }
@@ -203,26 +254,10 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
         const float3 *curve_keys = &hair->get_curve_keys()[0];
         const float4 *key_steps = curve_attr_mP->data_float4();
         const size_t num_keys = hair->get_curve_keys().size();
-        /* Calculate bounding box of the previous time step.
-         * Will be reused later to avoid duplicated work on
-         * calculating BVH time step boundbox.
+        /* Calculate bounding box of the primitive at every BVH time step,
+         * segments between them are created (and possibly merged) below.
          */
-        float4 prev_keys[4];
-        curve.cardinal_motion_keys(curve_keys,
-                                   curve_radius,
-                                   key_steps,
-                                   num_keys,
-                                   num_steps,
-                                   0.0f,
-                                   k - 1,
-                                   k,
-                                   k + 1,
-                                   k + 2,
-                                   prev_keys);
-        BoundBox prev_bounds = BoundBox::empty;
-        curve.bounds_grow(prev_keys, prev_bounds);
-        /* Create all primitive time steps, */
-        for (int bvh_step = 1; bvh_step < num_bvh_steps; ++bvh_step) {
+        for (int bvh_step = 0; bvh_step < num_bvh_steps; ++bvh_step) {
           const float curr_time = (float)(bvh_step)*num_bvh_steps_inv_1;
           float4 curr_keys[4];
           curve.cardinal_motion_keys(curve_keys,
@@ -236,23 +271,12 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
                                      k + 1,
                                      k + 2,
                                      curr_keys);
-          BoundBox curr_bounds = BoundBox::empty;
+          BoundBox &curr_bounds = motion_step_bounds[bvh_step];
+          curr_bounds = BoundBox::empty;
           curve.bounds_grow(curr_keys, curr_bounds);
-          BoundBox bounds = prev_bounds;
-          bounds.grow(curr_bounds);
-          if (bounds.valid()) {
-            const float prev_time = (float)(bvh_step - 1) * num_bvh_steps_inv_1;
-            int packed_type = PRIMITIVE_PACK_SEGMENT(primitive_type, k);
-            references.push_back(
-                BVHReference(bounds, j, object_index, packed_type, prev_time, curr_time));
-            root.grow(bounds);
-            center.grow(bounds.center2());
-          }
-          /* Current time boundbox becomes previous one for the
-           * next time step.
-           */
-          prev_bounds = curr_bounds;
         }
+        int packed_type = PRIMITIVE_PACK_SEGMENT(primitive_type, k);
+        add_reference_motion_steps(root, center, num_bvh_steps, j, object_index, packed_type);
       }
     }
   }
@@ -320,35 +344,18 @@ void BVHBuild::add_reference_points(BoundBox &root,
       const size_t num_steps = pointcloud->get_motion_steps();
       const float3 *point_steps = point_attr_mP->data_float3();
 
-      /* Calculate bounding box of the previous time step.
-       * Will be reused later to avoid duplicated work on
-       * calculating BVH time step boundbox.
+      /* Calculate bounding box of the primitive at every BVH time step,
+       * segments between them are created (and possibly merged) below.
        */
-      float4 prev_key = point.motion_key(
-          points_data, radius_data, point_steps, num_points, num_steps, 0.0f, j);
-      BoundBox prev_bounds = BoundBox::empty;
-      point.bounds_grow(prev_key, prev_bounds);
-      /* Create all primitive time steps, */
-      for (int bvh_step = 1; bvh_step < num_bvh_steps; ++bvh_step) {
+      for (int bvh_step = 0; bvh_step < num_bvh_steps; ++bvh_step) {
         const float curr_time = (float)(bvh_step)*num_bvh_steps_inv_1;
         float4 curr_key = point.motion_key(
             points_data, radius_data, point_steps, num_points, num_steps, curr_time, j);
-        BoundBox curr_bounds = BoundBox::empty;
+        BoundBox &curr_bounds = motion_step_bounds[bvh_step];
+        curr_bounds = BoundBox::empty;
         point.bounds_grow(curr_key, curr_bounds);
-        BoundBox bounds = prev_bounds;
-        bounds.grow(curr_bounds);
-        if (bounds.valid()) {
-          const float prev_time = (float)(bvh_step - 1) * num_bvh_steps_inv_1;
-          references.push_back(
-              BVHReference(bounds, j, i, PRIMITIVE_MOTION_POINT, prev_time, curr_time));
-          root.grow(bounds);
-          center.grow(bounds.center2());
-        }
-        /* Current time boundbox becomes previous one for the
-         * next time step.
-         */
-        prev_bounds = curr_bounds;
       }
+      add_reference_motion_steps(root, center, num_bvh_steps, j, i, PRIMITIVE_MOTION_POINT);
     }
   }
 }
@@ -431,6 +438,12 @@ void BVHBuild::add_references(BVHRange &root)
 
   references.reserve(num_alloc_references);
 
+  /* Storage for the per-time-step bounds of a single motion primitive. */
+  const int max_motion_steps = max(
+      params.num_motion_triangle_steps,
+      max(params.num_motion_curve_steps, params.num_motion_point_steps));
+  motion_step_bounds.resize(max_motion_steps * 2 + 1);
+
   /* add references from objects */
   BoundBox bounds = BoundBox::empty, center = BoundBox::empty;
   int i = 0;
@@ -558,6 +571,19 @@ BVHNode *BVHBuild::run()
                 << "\n"
                 << "  Maximum depth: "
                 << string_human_readable_number(rootnode->getSubtreeSize(BVH_STAT_DEPTH)) << "\n";
+      if (num_motion_segments != 0) {
+        /* Every reference ends up as an entry in each of the packed primitive arrays. */
+        const size_t reference_size = sizeof(int) * 3 + sizeof(float2);
+        VLOG_WORK << "BVH motion steps statistics:\n"
+                  << "  Number of motion time segments: "
+                  << string_human_readable_number(num_motion_segments) << "\n"
+                  << "  Number of motion references: "
+                  << string_human_readable_number(num_motion_references) << "\n"
+                  << "  Primitive memory saved by merging: "
+                  << string_human_readable_size((num_motion_segments - num_motion_references) *
+                                                reference_size)
+                  << "\n";
+      }
     }
   }
 
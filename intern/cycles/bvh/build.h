@@ -57,6 +57,12 @@ class BVHBuild {
   friend class BVHObjectBinning;
 
   /* Adding references. */
+  void add_reference_motion_steps(BoundBox &root,
+                                  BoundBox &center,
+                                  const int num_bvh_steps,
+                                  const int prim_index,
+                                  const int object_index,
+                                  const int prim_type);
   void add_reference_triangles(BoundBox &root, BoundBox &center, Mesh *mesh, int i);
   void add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair, int i);
   void add_reference_points(BoundBox &root, BoundBox &center, PointCloud *pointcloud, int i);
@@ -98,6 +104,14 @@ class BVHBuild {
   vector<BVHReference> references;
   int num_original_references;
 
+  /* Bounds of the motion primitive being added at every BVH time step. */
+  vector<BoundBox> motion_step_bounds;
+
+  /* Motion references statistics: number of references created and the number of time
+   * segments they cover, the difference is what got merged. */
+  size_t num_motion_references;
+  size_t num_motion_segments;
+
   /* Output primitive indexes and objects. */
   array<int> &prim_type;
   array<int> &prim_index;
@@ -101,6 +101,12 @@ class BVHParams {
   int num_motion_curve_steps;
   int num_motion_point_steps;
 
+  /* Neighbor time steps of a motion primitive are merged into a single reference when the
+   * time weighted surface area of the merged bounds is within this factor of the separate
+   * ones. Zero disables merging. Only used by the BVH2 builder, Embree and the GPU ray tracing
+   * libraries build their motion acceleration structures themselves. */
+  float motion_step_merge_tolerance;
+
   /* Same as in SceneParams. */
   int bvh_type;
 
@@ -138,6 +144,7 @@ class BVHParams {
     num_motion_curve_steps = 0;
     num_motion_triangle_steps = 0;
     num_motion_point_steps = 0;
+    motion_step_merge_tolerance = 1.1f;
 
     bvh_type = 0;
 
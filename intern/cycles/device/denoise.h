@@ -65,6 +65,10 @@ class DenoiseParams : public Node {
 
   DenoiserPrefilter prefilter = DENOISER_PREFILTER_FAST;
 
+  /* Memory budget in megabytes for denoising on the CPU. When the frame does not fit, it is
+   * denoised in tiles with overlapping borders. Zero denoises the full frame at once. */
+  int max_memory = 0;
+
   static const NodeEnum *get_type_enum();
   static const NodeEnum *get_prefilter_enum();
 
@@ -75,7 +79,8 @@ class DenoiseParams : public Node {
     return !(use == other.use && type == other.type && start_sample == other.start_sample &&
              use_pass_albedo == other.use_pass_albedo &&
              use_pass_normal == other.use_pass_normal &&
-             temporally_stable == other.temporally_stable && prefilter == other.prefilter);
+             temporally_stable == other.temporally_stable && prefilter == other.prefilter &&
+             max_memory == other.max_memory);
   }
 };
 
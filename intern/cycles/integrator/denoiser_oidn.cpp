@@ -13,6 +13,8 @@
 #include "util/array.h"
 #include "util/log.h"
 #include "util/openimagedenoise.h"
+#include "util/task.h"
+#include "util/tbb.h"
 
 #include "kernel/device/cpu/compat.h"
 #include "kernel/device/cpu/kernel.h"
@@ -88,6 +90,34 @@ class OIDNPass {
   array<float> scaled_buffer;
 };
 
+/* Region of the buffer denoised as a single image when denoising in tiles. The denoised image is
+ * only written back for the inner region, the overlap provides context to the denoiser so that
+ * there are no visible seams between tiles. */
+struct OIDNTile {
+  /* Region including the overlap, which is passed to the denoiser. */
+  int x = 0, y = 0;
+  int width = 0, height = 0;
+
+  /* Region written back to the render buffers, relative to the buffer. */
+  int inner_x = 0, inner_y = 0;
+  int inner_width = 0, inner_height = 0;
+};
+
+/* Compact 3-component images of a tile. */
+struct OIDNTileBuffers {
+  array<float> color;
+  array<float> albedo;
+  array<float> normal;
+  array<float> output;
+};
+
+/* Number of pixels around a tile which are passed to the denoiser for context. Matches the
+ * overlap used by the tiling inside OpenImageDenoise. */
+static constexpr int OIDN_TILE_OVERLAP = 128;
+
+/* Smallest inner tile size, to avoid the overlap dominating the amount of work. */
+static constexpr int OIDN_MIN_TILE_SIZE = 256;
+
 class OIDNDenoiseContext {
  public:
   OIDNDenoiseContext(OIDNDenoiser *denoiser,
@@ -122,6 +152,32 @@ class OIDNDenoiseContext {
     return true;
   }
 
+  /* Size of the inner region of tiles when the buffer is to be denoised in tiles, or zero when the
+   * buffer fits into the memory budget and is denoised at once.
+   *
+   * Half of the budget is used by the tile images, the other half is given to the denoiser.
+   * There are two sets of tile images, so that the next tile can be read while the current one
+   * is being denoised. */
+  int get_tile_size() const
+  {
+    if (denoise_params_.max_memory <= 0) {
+      return 0;
+    }
+
+    const int64_t num_images = 4;
+    const int64_t bytes_per_pixel = 2 * num_images * 3 * sizeof(float);
+    const int64_t budget = int64_t(denoise_params_.max_memory) * 1024 * 1024;
+    const int64_t full_size = int64_t(buffer_params_.width) * buffer_params_.height *
+                              bytes_per_pixel;
+
+    if (full_size <= budget / 2) {
+      return 0;
+    }
+
+    const int tile_size = int(sqrtf(float(budget / 2 / bytes_per_pixel))) - 2 * OIDN_TILE_OVERLAP;
+    return max(tile_size, OIDN_MIN_TILE_SIZE);
+  }
+
   /* Make the guiding passes available by a sequential denoising of various passes. */
   void read_guiding_passes()
   {
@@ -187,7 +243,327 @@ class OIDNDenoiseContext {
     postprocess_output(oidn_color_pass, oidn_output_pass);
   }
 
+  /* Denoise the pass in tiles of the given size, reading all images into compact per-tile
+   * buffers. Unlike the full buffer denoising the render buffers are only read for the noisy
+   * passes, so tiles do not affect each other.
+   *
+   * The mutex is only held while the denoiser runs, reading and writing the tiles happens in
+   * parallel with the denoising of other tiles or other buffers. */
+  void denoise_pass_tiled(const PassType pass_type, const int tile_size, thread_mutex &mutex)
+  {
+    OIDNPass oidn_color_pass(buffer_params_, "color", pass_type);
+    if (oidn_color_pass.offset == PASS_UNUSED) {
+      return;
+    }
+
+    OIDNPass oidn_output_pass(buffer_params_, "output", pass_type, PassMode::DENOISED);
+    if (oidn_output_pass.offset == PASS_UNUSED) {
+      LOG(DFATAL) << "Missing denoised pass " << pass_type_as_string(pass_type);
+      return;
+    }
+
+    const vector<OIDNTile> tiles = get_tiles(tile_size);
+    const float input_scale = get_input_scale(oidn_color_pass);
+
+    VLOG_WORK << "Denoising pass " << pass_type_as_string(pass_type) << " in " << tiles.size()
+              << " tiles of size " << tile_size << " with input scale " << input_scale;
+
+    oidn::DeviceRef oidn_device = oidn::newDevice();
+    oidn_device.set("setAffinity", false);
+    oidn_device.commit();
+
+    OIDNTileBuffers tile_buffers[2];
+    read_tile(tiles[0], oidn_color_pass, tile_buffers[0]);
+
+    TaskPool pool;
+
+    for (size_t i = 0; i < tiles.size(); i++) {
+      if (denoiser_->is_cancelled()) {
+        break;
+      }
+
+      /* Read the next tile while the current one is being denoised. */
+      if (i + 1 < tiles.size()) {
+        OIDNTileBuffers &next_buffers = tile_buffers[(i + 1) % 2];
+        pool.push([&, i]() { read_tile(tiles[i + 1], oidn_color_pass, next_buffers); });
+      }
+
+      OIDNTileBuffers &buffers = tile_buffers[i % 2];
+      {
+        thread_scoped_lock lock(mutex);
+        denoise_tile(oidn_device, tiles[i], oidn_color_pass, input_scale, buffers);
+      }
+      write_tile(tiles[i], oidn_color_pass, oidn_output_pass, buffers);
+
+      pool.wait_work();
+    }
+  }
+
  protected:
+  /* Split the buffer into tiles with the given inner size. */
+  vector<OIDNTile> get_tiles(const int tile_size) const
+  {
+    const int width = buffer_params_.width;
+    const int height = buffer_params_.height;
+
+    vector<OIDNTile> tiles;
+
+    for (int y = 0; y < height; y += tile_size) {
+      for (int x = 0; x < width; x += tile_size) {
+        OIDNTile tile;
+        tile.inner_x = x;
+        tile.inner_y = y;
+        tile.inner_width = min(tile_size, width - x);
+        tile.inner_height = min(tile_size, height - y);
+
+        tile.x = max(x - OIDN_TILE_OVERLAP, 0);
+        tile.y = max(y - OIDN_TILE_OVERLAP, 0);
+        tile.width = min(x + tile.inner_width + OIDN_TILE_OVERLAP, width) - tile.x;
+        tile.height = min(y + tile.inner_height + OIDN_TILE_OVERLAP, height) - tile.y;
+
+        tiles.push_back(tile);
+      }
+    }
+
+    return tiles;
+  }
+
+  /* Scale of the color pass which the auto-exposure of OpenImageDenoise computes for the whole
+   * buffer. It is used for every tile, as the auto-exposure of the individual tiles differs and
+   * causes seams between them.
+   *
+   * Matches the OpenImageDenoise implementation: the average log luminance of the image
+   * downsampled by a factor of 16 is mapped to middle gray. */
+  float get_input_scale(const OIDNPass &oidn_color_pass)
+  {
+    const float key = 0.18f;
+    const float eps = 1e-8f;
+    const int downsample = 16;
+
+    const int width = buffer_params_.width;
+    const int height = buffer_params_.height;
+    const int num_bins_x = (width + downsample / 2) / downsample;
+    const int num_bins_y = (height + downsample / 2) / downsample;
+
+    /* Sum of the log luminance and number of non-black bins for every row of bins. Only one row
+     * of bins is read at a time, to stay within the memory budget of tiled denoising. */
+    vector<float> row_log_luminance(num_bins_y, 0.0f);
+    vector<int> row_num_bins(num_bins_y, 0);
+
+    parallel_for(0, num_bins_y, [&](int bin_y) {
+      const int y_begin = int(int64_t(bin_y) * height / num_bins_y);
+      const int y_end = int(int64_t(bin_y + 1) * height / num_bins_y);
+      const int num_rows = y_end - y_begin;
+
+      vector<float> pixels(int64_t(width) * num_rows * 3);
+      read_pass_pixels(oidn_color_pass,
+                       PassAccessor::Destination(pixels.data(), 3),
+                       0,
+                       y_begin,
+                       width,
+                       num_rows);
+
+      for (int bin_x = 0; bin_x < num_bins_x; bin_x++) {
+        const int x_begin = int(int64_t(bin_x) * width / num_bins_x);
+        const int x_end = int(int64_t(bin_x + 1) * width / num_bins_x);
+
+        float luminance = 0.0f;
+        for (int y = 0; y < num_rows; y++) {
+          for (int x = x_begin; x < x_end; x++) {
+            const float *pixel = pixels.data() + (int64_t(y) * width + x) * 3;
+            /* Negative and NaN values are treated as zero. */
+            const float r = (pixel[0] > 0.0f) ? pixel[0] : 0.0f;
+            const float g = (pixel[1] > 0.0f) ? pixel[1] : 0.0f;
+            const float b = (pixel[2] > 0.0f) ? pixel[2] : 0.0f;
+            luminance += 0.212671f * r + 0.715160f * g + 0.072169f * b;
+          }
+        }
+        luminance /= num_rows * (x_end - x_begin);
+
+        if (luminance > eps) {
+          row_log_luminance[bin_y] += log2f(luminance);
+          row_num_bins[bin_y]++;
+        }
+      }
+    });
+
+    float log_luminance = 0.0f;
+    int num_bins = 0;
+    for (int bin_y = 0; bin_y < num_bins_y; bin_y++) {
+      log_luminance += row_log_luminance[bin_y];
+      num_bins += row_num_bins[bin_y];
+    }
+
+    return (num_bins > 0) ? key / exp2f(log_luminance / num_bins) : 1.0f;
+  }
+
+  /* Read scaled pixels of the color and guiding passes of the tile. */
+  void read_tile(const OIDNTile &tile, const OIDNPass &oidn_color_pass, OIDNTileBuffers &buffers)
+  {
+    const int64_t num_pixel_components = int64_t(tile.width) * tile.height * 3;
+
+    buffers.color.resize(num_pixel_components);
+    read_pass_pixels(oidn_color_pass,
+                     PassAccessor::Destination(buffers.color.data(), 3),
+                     tile.x,
+                     tile.y,
+                     tile.width,
+                     tile.height);
+
+    if (oidn_albedo_pass_) {
+      buffers.albedo.resize(num_pixel_components);
+      if (oidn_color_pass.use_denoising_albedo) {
+        read_pass_pixels(oidn_albedo_pass_,
+                         PassAccessor::Destination(buffers.albedo.data(), 3),
+                         tile.x,
+                         tile.y,
+                         tile.width,
+                         tile.height);
+      }
+      else {
+        /* NOTE: OpenImageDenoise library implicitly expects albedo pass when normal pass has been
+         * provided. */
+        for (int64_t i = 0; i < num_pixel_components; ++i) {
+          buffers.albedo[i] = 0.5f;
+        }
+      }
+    }
+
+    if (oidn_normal_pass_) {
+      buffers.normal.resize(num_pixel_components);
+      read_pass_pixels(oidn_normal_pass_,
+                       PassAccessor::Destination(buffers.normal.data(), 3),
+                       tile.x,
+                       tile.y,
+                       tile.width,
+                       tile.height);
+    }
+
+    buffers.output.resize(num_pixel_components);
+  }
+
+  void set_tile_image(oidn::FilterRef &oidn_filter,
+                      const char *name,
+                      const OIDNTile &tile,
+                      array<float> &pixels)
+  {
+    oidn_filter.setImage(name, pixels.data(), oidn::Format::Float3, tile.width, tile.height);
+  }
+
+  void filter_tile_image(oidn::DeviceRef &oidn_device,
+                         const char *name,
+                         const OIDNTile &tile,
+                         array<float> &pixels)
+  {
+    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    set_tile_image(oidn_filter, name, tile, pixels);
+    set_tile_image(oidn_filter, "output", tile, pixels);
+    oidn_filter.commit();
+    oidn_filter.execute();
+  }
+
+  void denoise_tile(oidn::DeviceRef &oidn_device,
+                    const OIDNTile &tile,
+                    const OIDNPass &oidn_color_pass,
+                    const float input_scale,
+                    OIDNTileBuffers &buffers)
+  {
+    if (denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE) {
+      if (oidn_albedo_pass_ && oidn_color_pass.use_denoising_albedo) {
+        filter_tile_image(oidn_device, "albedo", tile, buffers.albedo);
+      }
+      if (oidn_normal_pass_) {
+        filter_tile_image(oidn_device, "normal", tile, buffers.normal);
+      }
+    }
+
+    oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
+    set_tile_image(oidn_filter, "color", tile, buffers.color);
+    if (oidn_albedo_pass_) {
+      set_tile_image(oidn_filter, "albedo", tile, buffers.albedo);
+    }
+    if (oidn_normal_pass_) {
+      set_tile_image(oidn_filter, "normal", tile, buffers.normal);
+    }
+    set_tile_image(oidn_filter, "output", tile, buffers.output);
+    oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
+    oidn_filter.set("hdr", true);
+    oidn_filter.set("srgb", false);
+    oidn_filter.set("inputScale", input_scale);
+    /* Let the denoiser use the half of the budget not used by the tile images. */
+    oidn_filter.set("maxMemoryMB", max(denoise_params_.max_memory / 2, 1));
+    if (denoise_params_.prefilter == DENOISER_PREFILTER_NONE ||
+        denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE)
+    {
+      oidn_filter.set("cleanAux", true);
+    }
+    oidn_filter.commit();
+    oidn_filter.execute();
+
+    const char *error_message;
+    const oidn::Error error = oidn_device.getError(error_message);
+    if (error != oidn::Error::None && error != oidn::Error::Cancelled) {
+      LOG(ERROR) << "OpenImageDenoise error: " << error_message;
+    }
+  }
+
+  /* Write the inner region of the denoised tile to the output pass, scaled back to match the
+   * number of samples and with the alpha channel of the noisy pass. */
+  void write_tile(const OIDNTile &tile,
+                  const OIDNPass &oidn_input_pass,
+                  const OIDNPass &oidn_output_pass,
+                  const OIDNTileBuffers &buffers)
+  {
+    const int64_t x = buffer_params_.full_x;
+    const int64_t y = buffer_params_.full_y;
+    const int64_t offset = buffer_params_.offset;
+    const int64_t stride = buffer_params_.stride;
+    const int64_t pass_stride = buffer_params_.pass_stride;
+    const int64_t row_stride = stride * pass_stride;
+
+    const int64_t pixel_offset = offset + x + y * stride;
+    const int64_t buffer_offset = (pixel_offset * pass_stride);
+
+    float *buffer_data = render_buffers_->buffer.data();
+
+    const bool has_pass_sample_count = (pass_sample_count_ != PASS_UNUSED);
+
+    parallel_for(0, tile.inner_height, [&](int64_t inner_y) {
+      const int64_t buffer_y = tile.inner_y + inner_y;
+      const int64_t tile_y = buffer_y - tile.y;
+
+      float *buffer_row = buffer_data + buffer_offset + buffer_y * row_stride;
+      const float *tile_row = buffers.output.data() + tile_y * tile.width * 3;
+
+      for (int64_t buffer_x = tile.inner_x; buffer_x < tile.inner_x + tile.inner_width;
+           ++buffer_x) {
+        float *buffer_pixel = buffer_row + buffer_x * pass_stride;
+        float *denoised_pixel = buffer_pixel + oidn_output_pass.offset;
+        const float *tile_pixel = tile_row + (buffer_x - tile.x) * 3;
+
+        /* All tile images are read scaled, so always scale back. */
+        const float pixel_scale = has_pass_sample_count ?
+                                      __float_as_uint(buffer_pixel[pass_sample_count_]) :
+                                      num_samples_;
+
+        denoised_pixel[0] = tile_pixel[0] * pixel_scale;
+        denoised_pixel[1] = tile_pixel[1] * pixel_scale;
+        denoised_pixel[2] = tile_pixel[2] * pixel_scale;
+
+        if (oidn_output_pass.num_components == 3) {
+          /* Pass without alpha channel. */
+        }
+        else if (!oidn_input_pass.use_compositing) {
+          const float *noisy_pixel = buffer_pixel + oidn_input_pass.offset;
+          denoised_pixel[3] = noisy_pixel[3];
+        }
+        else {
+          denoised_pixel[3] = 0;
+        }
+      }
+    });
+  }
+
   void filter_guiding_pass_if_needed(oidn::DeviceRef &oidn_device, OIDNPass &oidn_pass)
   {
     if (denoise_params_.prefilter != DENOISER_PREFILTER_ACCURATE || !oidn_pass ||
@@ -257,6 +633,17 @@ class OIDNDenoiseContext {
 
   /* Read pass pixels using PassAccessor into the given destination. */
   void read_pass_pixels(const OIDNPass &oidn_pass, const PassAccessor::Destination &destination)
+  {
+    read_pass_pixels(oidn_pass, destination, 0, 0, buffer_params_.width, buffer_params_.height);
+  }
+
+  /* Read pixels of the given region of the pass. */
+  void read_pass_pixels(const OIDNPass &oidn_pass,
+                        const PassAccessor::Destination &destination,
+                        const int x,
+                        const int y,
+                        const int width,
+                        const int height)
   {
     PassAccessor::PassAccessInfo pass_access_info;
     pass_access_info.type = oidn_pass.type;
@@ -275,11 +662,15 @@ class OIDNDenoiseContext {
      * pixels. */
     const PassAccessorCPU pass_accessor(pass_access_info, 1.0f, num_samples_);
 
+    /* The destination only holds the pixels of the region, so the accessor uses the region size
+     * to address its rows. */
     BufferParams buffer_params = buffer_params_;
-    buffer_params.window_x = 0;
-    buffer_params.window_y = 0;
-    buffer_params.window_width = buffer_params.width;
-    buffer_params.window_height = buffer_params.height;
+    buffer_params.width = width;
+    buffer_params.height = height;
+    buffer_params.window_x = x;
+    buffer_params.window_y = y;
+    buffer_params.window_width = width;
+    buffer_params.window_height = height;
 
     pass_accessor.get_render_tile_pixels(render_buffers_, buffer_params, destination);
   }
@@ -577,8 +968,6 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
       << "OpenImageDenoiser is not supported on this platform or build.";
 
 #ifdef WITH_OPENIMAGEDENOISE
-  thread_scoped_lock lock(mutex_);
-
   /* Make sure the host-side data is available for denoising. */
   unique_ptr<DeviceQueue> queue = create_device_queue(render_buffers);
   copy_render_buffers_from_device(queue, render_buffers);
@@ -587,8 +976,6 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
       this, params_, buffer_params, render_buffers, num_samples, allow_inplace_modification);
 
   if (context.need_denoising()) {
-    context.read_guiding_passes();
-
     const std::array<PassType, 3> passes = {
         {/* Passes which will use real albedo when it is available. */
          PASS_COMBINED,
@@ -598,10 +985,26 @@ bool OIDNDenoiser::denoise_buffer(const BufferParams &buffer_params,
           */
          PASS_SHADOW_CATCHER}};
 
-    for (const PassType pass_type : passes) {
-      context.denoise_pass(pass_type);
-      if (is_cancelled()) {
-        return false;
+    const int tile_size = context.get_tile_size();
+
+    if (tile_size) {
+      for (const PassType pass_type : passes) {
+        context.denoise_pass_tiled(pass_type, tile_size, mutex_);
+        if (is_cancelled()) {
+          return false;
+        }
+      }
+    }
+    else {
+      thread_scoped_lock lock(mutex_);
+
+      context.read_guiding_passes();
+
+      for (const PassType pass_type : passes) {
+        context.denoise_pass(pass_type);
+        if (is_cancelled()) {
+          return false;
+        }
       }
     }
 
@@ -29,7 +29,8 @@ class OIDNDenoiser : public Denoiser {
   virtual Device *ensure_denoiser_device(Progress *progress) override;
 
   /* We only perform one denoising at a time, since OpenImageDenoise itself is multithreaded.
-   * Use this mutex whenever images are passed to the OIDN and needs to be denoised. */
+   * Use this mutex whenever images are passed to the OIDN and needs to be denoised. When denoising
+   * in tiles it is only held while a tile is denoised. */
   static thread_mutex mutex_;
 };
 
@@ -451,6 +451,7 @@ void PathTrace::adaptive_sample(RenderWork &render_work)
 
     render_scheduler_.report_adaptive_filter_time(
         render_work, time_dt() - start_time, is_cancel_requested());
+    render_scheduler_.report_adaptive_filter_result(render_work, num_active_pixels);
 
     if (num_active_pixels == 0) {
       VLOG_WORK << "All pixels converged.";
@@ -951,26 +952,43 @@ bool PathTrace::copy_render_tile_from_device()
   return success;
 }
 
-static string get_layer_view_name(const RenderBuffers &buffers)
+static string get_layer_view_name(const BufferParams &buffer_params)
 {
   string result;
 
-  if (buffers.params.layer.size()) {
-    result += string(buffers.params.layer);
+  if (buffer_params.layer.size()) {
+    result += string(buffer_params.layer);
   }
 
-  if (buffers.params.view.size()) {
+  if (buffer_params.view.size()) {
     if (!result.empty()) {
       result += ", ";
     }
-    result += string(buffers.params.view);
+    result += string(buffer_params.view);
   }
 
   return result;
 }
 
-void PathTrace::process_full_buffer_from_disk(string_view filename)
+void PathTrace::full_buffer_read_error()
 {
+  const string error_message = "Error reading tiles from file";
+  if (progress_) {
+    progress_->set_error(error_message);
+    progress_->set_cancel(error_message);
+  }
+  else {
+    LOG(ERROR) << error_message;
+  }
+}
+
+void PathTrace::process_full_buffer_from_disk(string_view filename, const int stream_tile_size)
+{
+  if (stream_tile_size > 0) {
+    process_full_buffer_from_disk_streamed(filename, stream_tile_size);
+    return;
+  }
+
   VLOG_WORK << "Processing full frame buffer file " << filename;
 
   progress_set_status("Reading full buffer from disk");
@@ -979,18 +997,11 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
 
   DenoiseParams denoise_params;
   if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
-    if (progress_) {
-      progress_->set_error(error_message);
-      progress_->set_cancel(error_message);
-    }
-    else {
-      LOG(ERROR) << error_message;
-    }
+    full_buffer_read_error();
     return;
   }
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  const string layer_view_name = get_layer_view_name(full_frame_buffers.params);
 
   render_state_.has_denoised_result = false;
 
@@ -1022,6 +1033,77 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   full_frame_state_.render_buffers = nullptr;
 }
 
+void PathTrace::process_full_buffer_from_disk_streamed(string_view filename,
+                                                       const int stream_tile_size)
+{
+  VLOG_WORK << "Processing full frame buffer file " << filename << " in tiles of "
+            << stream_tile_size << " pixels";
+
+  BufferParams full_params;
+  DenoiseParams denoise_params;
+  if (!tile_manager_.open_full_buffer_from_disk(filename, &full_params, &denoise_params)) {
+    full_buffer_read_error();
+    return;
+  }
+
+  const string layer_view_name = get_layer_view_name(full_params);
+
+  /* Regions are read from the file on its image tile boundaries, which follow the render tile
+   * size the file was written with. The border around each region gives the denoiser enough
+   * context for the seams between regions to be invisible. */
+  const int2 image_tile_size = tile_manager_.get_full_buffer_image_tile_size();
+  auto align_to_image_tiles = [&](const int size) {
+    return make_int2(int(divide_up(size, image_tile_size.x)) * image_tile_size.x,
+                     int(divide_up(size, image_tile_size.y)) * image_tile_size.y);
+  };
+  const int2 tile_size = align_to_image_tiles(stream_tile_size);
+  const int2 border = denoise_params.use ? align_to_image_tiles(TileManager::IMAGE_TILE_SIZE) :
+                                           make_int2(0, 0);
+
+  const int num_tiles_x = divide_up(full_params.width, tile_size.x);
+  const int num_tiles_y = divide_up(full_params.height, tile_size.y);
+  const int num_tiles = num_tiles_x * num_tiles_y;
+
+  if (denoise_params.use) {
+    /* See the comment in `process_full_buffer_from_disk()` about re-using the denoiser. */
+    set_denoiser_params(denoise_params);
+  }
+
+  RenderBuffers region_buffers(cpu_device_.get());
+
+  for (int tile_index = 0; tile_index < num_tiles; ++tile_index) {
+    const int tile_y = tile_index / num_tiles_x;
+    const int tile_x = tile_index - tile_y * num_tiles_x;
+    const int4 region = make_int4(
+        tile_x * tile_size.x, tile_y * tile_size.y, tile_size.x, tile_size.y);
+
+    progress_set_status(layer_view_name,
+                        string_printf("Processing tile %d/%d", tile_index + 1, num_tiles));
+
+    if (!tile_manager_.read_full_buffer_region_from_disk(region, border, &region_buffers)) {
+      full_buffer_read_error();
+      break;
+    }
+
+    render_state_.has_denoised_result = false;
+
+    if (denoise_params.use) {
+      denoiser_->denoise_buffer(region_buffers.params, &region_buffers, 0, false);
+      render_state_.has_denoised_result = true;
+    }
+
+    full_frame_state_.render_buffers = &region_buffers;
+    full_frame_state_.offset = make_int2(region.x, region.y);
+
+    tile_buffer_write();
+
+    full_frame_state_.render_buffers = nullptr;
+    full_frame_state_.offset = make_int2(0, 0);
+  }
+
+  tile_manager_.close_full_buffer_from_disk();
+}
+
 int PathTrace::get_num_render_tile_samples() const
 {
   if (full_frame_state_.render_buffers) {
@@ -1092,7 +1174,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
@@ -135,8 +135,11 @@ class PathTrace {
   bool copy_render_tile_from_device();
 
   /* Read given full-frame file from disk, perform needed processing and write it to the software
-   * via the write callback. */
-  void process_full_buffer_from_disk(string_view filename);
+   * via the write callback.
+   *
+   * When the stream tile size is non-zero the full frame is never held in memory. Instead it is
+   * read, denoised and written to the software in tiles of the given size. */
+  void process_full_buffer_from_disk(string_view filename, int stream_tile_size = 0);
 
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
@@ -239,6 +242,13 @@ class PathTrace {
   /* Write current tile into the file on disk. */
   void tile_buffer_write_to_disk();
 
+  /* Process full-frame file from disk in tiles of the given size, writing every tile to the
+   * software via the write callback as soon as it is denoised. */
+  void process_full_buffer_from_disk_streamed(string_view filename, int stream_tile_size);
+
+  /* Report failure of reading the full-frame file from disk. */
+  void full_buffer_read_error();
+
   /* Run the progress_update_cb callback if it is needed. */
   void progress_update_if_needed(const RenderWork &render_work);
 
@@ -349,6 +359,10 @@ class PathTrace {
   /* State of the full frame processing and writing to the software. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+
+    /* Offset of the render buffers window within the full frame. Non-zero when the full frame is
+     * processed in tiles. */
+    int2 offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
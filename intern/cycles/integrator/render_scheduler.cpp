@@ -4,6 +4,8 @@
 
 #include "integrator/render_scheduler.h"
 
+#include "scene/integrator.h"
+
 #include "session/session.h"
 #include "session/tile.h"
 #include "util/log.h"
@@ -101,6 +103,16 @@ double RenderScheduler::get_time_limit() const
   return time_limit_;
 }
 
+void RenderScheduler::set_time_budget(bool use_time_budget)
+{
+  use_time_budget_ = use_time_budget;
+}
+
+bool RenderScheduler::is_time_budget_used() const
+{
+  return use_time_budget_ && time_limit_ != 0.0 && adaptive_sampling_.use;
+}
+
 int RenderScheduler::get_rendered_sample() const
 {
   DCHECK_GT(get_num_rendered_samples(), 0);
@@ -159,6 +171,10 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples,
   state_.end_render_time = 0.0;
   state_.time_limit_reached = false;
 
+  state_.adaptive_num_active_pixels = 0;
+  state_.adaptive_converged_threshold = 0.0f;
+  state_.time_budget_reported = false;
+
   state_.occupancy_num_samples = 0;
   state_.occupancy = 1.0f;
 
@@ -203,7 +219,7 @@ bool RenderScheduler::render_work_reschedule_on_converge(RenderWork &render_work
 
 bool RenderScheduler::render_work_reschedule_on_idle(RenderWork &render_work)
 {
-  if (!use_progressive_noise_floor_) {
+  if (!use_progressive_noise_floor()) {
     return false;
   }
 
@@ -283,7 +299,7 @@ bool RenderScheduler::done() const
     return true;
   }
 
-  return get_num_rendered_samples() >= num_samples_;
+  return get_num_rendered_samples() >= get_num_samples_limit();
 }
 
 RenderWork RenderScheduler::get_render_work()
@@ -302,6 +318,11 @@ RenderWork RenderScheduler::get_render_work()
 
     if (!render_work) {
       state_.end_render_time = time_now;
+
+      if (is_time_budget_used() && !state_.time_budget_reported) {
+        VLOG_INFO << time_budget_report();
+        state_.time_budget_reported = true;
+      }
     }
 
     update_state_for_render_work(render_work);
@@ -527,6 +548,16 @@ void RenderScheduler::report_adaptive_filter_time(const RenderWork &render_work,
             << " seconds.";
 }
 
+void RenderScheduler::report_adaptive_filter_result(const RenderWork &render_work,
+                                                    uint num_active_pixels)
+{
+  state_.adaptive_num_active_pixels = num_active_pixels;
+
+  if (num_active_pixels == 0) {
+    state_.adaptive_converged_threshold = render_work.adaptive_sampling.threshold;
+  }
+}
+
 void RenderScheduler::report_denoise_time(const RenderWork &render_work, double time)
 {
   denoise_time_.add_wall(time);
@@ -687,6 +718,10 @@ string RenderScheduler::full_report() const
   result += string_printf(
       "\nRendered %d samples in %f seconds\n", num_rendered_samples, render_wall_time);
 
+  if (is_time_budget_used()) {
+    result += time_budget_report() + "\n";
+  }
+
   /* When adaptive sampling is used the average time becomes meaningless, because different samples
    * will likely render different number of pixels. */
   if (!adaptive_sampling_.use) {
@@ -845,7 +880,8 @@ int RenderScheduler::get_num_samples_to_path_trace() const
    * more than N samples. */
   const int num_samples_pot = round_num_samples_to_power_of_2(num_samples_per_update);
 
-  const int max_num_samples_to_render = start_sample_ + num_samples_ - path_trace_start_sample;
+  const int max_num_samples_to_render = start_sample_ + get_num_samples_limit() -
+                                        path_trace_start_sample;
 
   int num_samples_to_render = min(num_samples_pot, max_num_samples_to_render);
 
@@ -926,7 +962,7 @@ bool RenderScheduler::work_need_adaptive_filter() const
 
 float RenderScheduler::work_adaptive_threshold() const
 {
-  if (!use_progressive_noise_floor_) {
+  if (!use_progressive_noise_floor()) {
     return adaptive_sampling_.threshold;
   }
 
@@ -1189,6 +1225,54 @@ void RenderScheduler::check_time_limit_reached()
   state_.end_render_time = current_time;
 }
 
+int RenderScheduler::get_max_num_samples(const int num_samples, const bool use_time_budget)
+{
+  if (!use_time_budget) {
+    return num_samples;
+  }
+
+  /* Allow to sample up to twice as long when the time budget is not used up yet, stopping on
+   * convergence or time limit otherwise. */
+  return min(num_samples * 2, Integrator::MAX_SAMPLES);
+}
+
+int RenderScheduler::get_num_samples_limit() const
+{
+  return get_max_num_samples(num_samples_, is_time_budget_used());
+}
+
+bool RenderScheduler::use_progressive_noise_floor() const
+{
+  return use_progressive_noise_floor_ || is_time_budget_used();
+}
+
+string RenderScheduler::time_budget_report() const
+{
+  const int num_pixels = buffer_params_.width * buffer_params_.height;
+  const float active_fraction = (num_pixels) ?
+                                    float(state_.adaptive_num_active_pixels) / num_pixels :
+                                    0.0f;
+
+  string result = string_printf("Time budget: %d samples in %f seconds, ",
+                                get_num_rendered_samples(),
+                                state_.end_render_time - state_.start_render_time);
+
+  if (state_.adaptive_converged_threshold != 0.0f) {
+    result += string_printf("noise threshold %f reached (target %f)",
+                            state_.adaptive_converged_threshold,
+                            adaptive_sampling_.threshold);
+  }
+  else {
+    result += string_printf("noise threshold %f not reached", adaptive_sampling_.threshold);
+  }
+
+  if (state_.adaptive_num_active_pixels) {
+    result += string_printf(", %.2f%% of pixels still noisier", active_fraction * 100.0f);
+  }
+
+  return result;
+}
+
 /* --------------------------------------------------------------------
  * Utility functions.
  */
@@ -122,6 +122,18 @@ class RenderScheduler {
   void set_time_limit(double time_limit);
   double get_time_limit() const;
 
+  /* Treat the time limit as a budget for reaching the adaptive sampling threshold: the noise
+   * floor is lowered progressively so the image has a uniform noise level whenever the budget
+   * runs out, and sampling continues past the number of samples while pixels did not converge
+   * and time remains. Only has effect with adaptive sampling and a time limit. */
+  void set_time_budget(bool use_time_budget);
+  bool is_time_budget_used() const;
+
+  /* Largest number of samples which can be rendered for the given number of samples. It is
+   * higher than the number of samples in the time budget mode, the sampling pattern needs to be
+   * configured for it. */
+  static int get_max_num_samples(int num_samples, bool use_time_budget);
+
   /* Get sample up to which rendering has been done.
    * This is an absolute 0-based value.
    *
@@ -180,6 +192,7 @@ class RenderScheduler {
   void report_path_trace_time(const RenderWork &render_work, double time, bool is_cancelled);
   void report_path_trace_occupancy(const RenderWork &render_work, float occupancy);
   void report_adaptive_filter_time(const RenderWork &render_work, double time, bool is_cancelled);
+  void report_adaptive_filter_result(const RenderWork &render_work, uint num_active_pixels);
   void report_denoise_time(const RenderWork &render_work, double time);
   void report_display_update_time(const RenderWork &render_work, double time);
   void report_rebalance_time(const RenderWork &render_work, double time, bool balance_changed);
@@ -278,6 +291,15 @@ class RenderScheduler {
    * average render time information. */
   void check_time_limit_reached();
 
+  /* Number of samples to render, including samples added by the time budget. */
+  int get_num_samples_limit() const;
+
+  /* Whether the adaptive sampling threshold is lowered progressively. */
+  bool use_progressive_noise_floor() const;
+
+  /* Noise level achieved within the time budget, for logs and reports. */
+  string time_budget_report() const;
+
   /* Helper class to keep track of task timing.
    *
    * Contains two parts: wall time and average. The wall time is an actual wall time of how long it
@@ -374,6 +396,12 @@ class RenderScheduler {
     bool path_trace_finished = false;
     bool time_limit_reached = false;
 
+    /* Result of the latest adaptive sampling filter: pixels which did not converge yet, and the
+     * lowest threshold all pixels converged to. */
+    uint adaptive_num_active_pixels = 0;
+    float adaptive_converged_threshold = 0.0f;
+    bool time_budget_reported = false;
+
     /* Time at which rendering started and finished. */
     double start_render_time = 0.0;
     double end_render_time = 0.0;
@@ -421,6 +449,8 @@ class RenderScheduler {
    * Zero means no limit is applied. */
   double time_limit_ = 0.0;
 
+  bool use_time_budget_ = false;
+
   /* Headless rendering without interface. */
   bool headless_;
 
@@ -38,6 +38,8 @@ KERNEL_DATA_ARRAY(packed_float3, tri_verts)
 /* curves */
 KERNEL_DATA_ARRAY(KernelCurve, curves)
 KERNEL_DATA_ARRAY(float4, curve_keys)
+KERNEL_DATA_ARRAY(uint, curve_keys_compact)
+KERNEL_DATA_ARRAY(float4, curve_key_ranges)
 KERNEL_DATA_ARRAY(KernelCurveSegment, curve_segments)
 
 /* patches */
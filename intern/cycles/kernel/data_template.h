@@ -58,6 +58,11 @@ KERNEL_STRUCT_MEMBER(bvh, int, have_volumes)
 KERNEL_STRUCT_MEMBER(bvh, int, bvh_layout)
 KERNEL_STRUCT_MEMBER(bvh, int, use_bvh_steps)
 KERNEL_STRUCT_MEMBER(bvh, int, curve_subdivisions)
+/* Curve keys are quantized, see curve_key(). */
+KERNEL_STRUCT_MEMBER(bvh, int, use_compact_curves)
+KERNEL_STRUCT_MEMBER(bvh, int, pad1)
+KERNEL_STRUCT_MEMBER(bvh, int, pad2)
+KERNEL_STRUCT_MEMBER(bvh, int, pad3)
 KERNEL_STRUCT_END(KernelBVH)
 
 /* Film. */
@@ -795,6 +795,59 @@ template<typename TexT, typename OutT = float4> struct NanoVDBInterpolator {
 
 #undef SET_CUBIC_SPLINE_WEIGHTS
 
+/* Approximate number of bytes read from the image memory by a single lookup, used for profiling.
+ * Sparse NanoVDB grids are counted as dense float grids. */
+ccl_device_inline uint64_t kernel_tex_image_lookup_bytes(const TextureInfo &info,
+                                                         const int interpolation,
+                                                         const int num_dimensions)
+{
+  int texel_size;
+  switch (info.data_type) {
+    case IMAGE_DATA_TYPE_BYTE:
+      texel_size = 1;
+      break;
+    case IMAGE_DATA_TYPE_HALF:
+    case IMAGE_DATA_TYPE_USHORT:
+    case IMAGE_DATA_TYPE_NANOVDB_FP16:
+      texel_size = 2;
+      break;
+    case IMAGE_DATA_TYPE_HALF4:
+    case IMAGE_DATA_TYPE_USHORT4:
+      texel_size = 8;
+      break;
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
+      texel_size = 12;
+      break;
+    case IMAGE_DATA_TYPE_FLOAT4:
+      texel_size = 16;
+      break;
+    default:
+      texel_size = 4;
+      break;
+  }
+
+  /* Number of texels along every dimension of the interpolation footprint. */
+  int footprint;
+  switch (interpolation) {
+    case INTERPOLATION_CLOSEST:
+      footprint = 1;
+      break;
+    case INTERPOLATION_LINEAR:
+      footprint = 2;
+      break;
+    default:
+      footprint = 4;
+      break;
+  }
+
+  uint64_t num_texels = 1;
+  for (int i = 0; i < num_dimensions; i++) {
+    num_texels *= footprint;
+  }
+
+  return num_texels * texel_size;
+}
+
 ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, float y)
 {
   const TextureInfo &info = kernel_data_fetch(texture_info, id);
@@ -803,6 +856,8 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals kg, int id, float x, flo
     return zero_float4();
   }
 
+  PROFILING_IMAGE_FETCH(kg, id, kernel_tex_image_lookup_bytes(info, info.interpolation, 2));
+
   switch (info.data_type) {
     case IMAGE_DATA_TYPE_HALF: {
       const float f = TextureInterpolator<half, float>::interp(info, x, y);
@@ -846,6 +901,12 @@ ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals kg,
     return zero_float4();
   }
 
+  PROFILING_IMAGE_FETCH(
+      kg,
+      id,
+      kernel_tex_image_lookup_bytes(
+          info, (interp == INTERPOLATION_NONE) ? info.interpolation : interp, 3));
+
   if (info.use_transform_3d) {
     P = transform_point(&info.transform_3d, P);
   }
@@ -644,10 +644,10 @@ ccl_device_forceinline bool curve_intersect(KernelGlobals kg,
 
   float4 curve[4];
   if (!is_motion) {
-    curve[0] = kernel_data_fetch(curve_keys, ka);
-    curve[1] = kernel_data_fetch(curve_keys, k0);
-    curve[2] = kernel_data_fetch(curve_keys, k1);
-    curve[3] = kernel_data_fetch(curve_keys, kb);
+    curve[0] = curve_key(kg, prim, ka);
+    curve[1] = curve_key(kg, prim, k0);
+    curve[2] = curve_key(kg, prim, k1);
+    curve[3] = curve_key(kg, prim, kb);
   }
   else {
     motion_curve_keys(kg, object, prim, time, ka, k0, k1, kb, curve);
@@ -703,10 +703,10 @@ ccl_device_inline void curve_shader_setup(KernelGlobals kg,
   float4 P_curve[4];
 
   if (!(sd->type & PRIMITIVE_MOTION)) {
-    P_curve[0] = kernel_data_fetch(curve_keys, ka);
-    P_curve[1] = kernel_data_fetch(curve_keys, k0);
-    P_curve[2] = kernel_data_fetch(curve_keys, k1);
-    P_curve[3] = kernel_data_fetch(curve_keys, kb);
+    P_curve[0] = curve_key(kg, isect_prim, ka);
+    P_curve[1] = curve_key(kg, isect_prim, k0);
+    P_curve[2] = curve_key(kg, isect_prim, k1);
+    P_curve[3] = curve_key(kg, isect_prim, kb);
   }
   else {
     motion_curve_keys(kg, sd->object, sd->prim, sd->time, ka, k0, k1, kb, P_curve);
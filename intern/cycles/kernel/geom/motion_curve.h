@@ -17,7 +17,26 @@ CCL_NAMESPACE_BEGIN
 
 #ifdef __HAIR__
 
+/* Fetch curve key location and radius, decoding compact keys when used. Positions are stored
+ * as 16 bit offsets within the bounds of the curve, radii as the upper 16 bits of a float. */
+ccl_device_inline float4 curve_key(KernelGlobals kg, const int prim, const int k)
+{
+  if (kernel_data.bvh.use_compact_curves) {
+    const float4 range = kernel_data_fetch(curve_key_ranges, prim);
+    const uint xy = kernel_data_fetch(curve_keys_compact, k * 2 + 0);
+    const uint zr = kernel_data_fetch(curve_keys_compact, k * 2 + 1);
+
+    return make_float4(range.x + (float)(xy & 0xFFFF) * range.w,
+                       range.y + (float)(xy >> 16) * range.w,
+                       range.z + (float)(zr & 0xFFFF) * range.w,
+                       __uint_as_float(zr & 0xFFFF0000));
+  }
+
+  return kernel_data_fetch(curve_keys, k);
+}
+
 ccl_device_inline void motion_curve_keys_for_step_linear(KernelGlobals kg,
+                                                         int prim,
                                                          int offset,
                                                          int numkeys,
                                                          int numsteps,
@@ -28,8 +47,8 @@ ccl_device_inline void motion_curve_keys_for_step_linear(KernelGlobals kg,
 {
   if (step == numsteps) {
     /* center step: regular key location */
-    keys[0] = kernel_data_fetch(curve_keys, k0);
-    keys[1] = kernel_data_fetch(curve_keys, k1);
+    keys[0] = curve_key(kg, prim, k0);
+    keys[1] = curve_key(kg, prim, k1);
   }
   else {
     /* center step is not stored in this array */
@@ -63,8 +82,9 @@ ccl_device_inline void motion_curve_keys_linear(
   /* fetch key coordinates */
   float4 next_keys[2];
 
-  motion_curve_keys_for_step_linear(kg, offset, numkeys, numsteps, step, k0, k1, keys);
-  motion_curve_keys_for_step_linear(kg, offset, numkeys, numsteps, step + 1, k0, k1, next_keys);
+  motion_curve_keys_for_step_linear(kg, prim, offset, numkeys, numsteps, step, k0, k1, keys);
+  motion_curve_keys_for_step_linear(
+      kg, prim, offset, numkeys, numsteps, step + 1, k0, k1, next_keys);
 
   /* interpolate between steps */
   keys[0] = (1.0f - t) * keys[0] + t * next_keys[0];
@@ -72,6 +92,7 @@ ccl_device_inline void motion_curve_keys_linear(
 }
 
 ccl_device_inline void motion_curve_keys_for_step(KernelGlobals kg,
+                                                  int prim,
                                                   int offset,
                                                   int numkeys,
                                                   int numsteps,
@@ -84,10 +105,10 @@ ccl_device_inline void motion_curve_keys_for_step(KernelGlobals kg,
 {
   if (step == numsteps) {
     /* center step: regular key location */
-    keys[0] = kernel_data_fetch(curve_keys, k0);
-    keys[1] = kernel_data_fetch(curve_keys, k1);
-    keys[2] = kernel_data_fetch(curve_keys, k2);
-    keys[3] = kernel_data_fetch(curve_keys, k3);
+    keys[0] = curve_key(kg, prim, k0);
+    keys[1] = curve_key(kg, prim, k1);
+    keys[2] = curve_key(kg, prim, k2);
+    keys[3] = curve_key(kg, prim, k3);
   }
   else {
     /* center step is not stored in this array */
@@ -130,8 +151,9 @@ ccl_device_inline void motion_curve_keys(KernelGlobals kg,
   /* fetch key coordinates */
   float4 next_keys[4];
 
-  motion_curve_keys_for_step(kg, offset, numkeys, numsteps, step, k0, k1, k2, k3, keys);
-  motion_curve_keys_for_step(kg, offset, numkeys, numsteps, step + 1, k0, k1, k2, k3, next_keys);
+  motion_curve_keys_for_step(kg, prim, offset, numkeys, numsteps, step, k0, k1, k2, k3, keys);
+  motion_curve_keys_for_step(
+      kg, prim, offset, numkeys, numsteps, step + 1, k0, k1, k2, k3, next_keys);
 
   /* interpolate between steps */
   keys[0] = (1.0f - t) * keys[0] + t * next_keys[0];
@@ -326,10 +326,10 @@ ccl_device void shader_setup_from_curve(KernelGlobals kg,
 
   float4 P_curve[4];
 
-  P_curve[0] = kernel_data_fetch(curve_keys, ka);
-  P_curve[1] = kernel_data_fetch(curve_keys, k0);
-  P_curve[2] = kernel_data_fetch(curve_keys, k1);
-  P_curve[3] = kernel_data_fetch(curve_keys, kb);
+  P_curve[0] = curve_key(kg, prim, ka);
+  P_curve[1] = curve_key(kg, prim, k0);
+  P_curve[2] = curve_key(kg, prim, k1);
+  P_curve[3] = curve_key(kg, prim, kb);
 
   /* Interpolate position and tangent. */
   sd->P = float4_to_float3(catmull_rom_basis_derivative(P_curve, sd->u));
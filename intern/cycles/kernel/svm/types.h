@@ -358,6 +358,8 @@ typedef enum NodeImageProjection {
 typedef enum NodeImageFlags {
   NODE_IMAGE_COMPRESS_AS_SRGB = 1,
   NODE_IMAGE_ALPHA_UNASSOCIATE = 2,
+  /* Texture coordinate is transformed by the matrix stored after the node. */
+  NODE_IMAGE_TRANSFORM_VECTOR = 4,
 } NodeImageFlags;
 
 typedef enum NodeEnvironmentProjection {
@@ -429,6 +429,62 @@ ccl_device float4 voronoi_position(const float3 coord)
   return float3_to_float4(coord);
 }
 
+#ifdef __KERNEL_SSE__
+/* Compute the feature points and their distances for the three cells of a row along the x axis
+ * at once. The cells with offsets -1, 0 and 1 are in the first three lanes, the last lane is
+ * unused.
+ *
+ * The feature points are the same as in the scalar code, but the components of the distances
+ * are summed in a different order than in voronoi_distance(), which uses a dot product. So the
+ * distances can differ in the last bits, and cells at almost the same distance may be picked in
+ * a different order. */
+ccl_device_inline float4 voronoi_row_distances(ccl_private const VoronoiParams &params,
+                                               const float3 cellPosition,
+                                               const float3 localPosition,
+                                               const int j,
+                                               const int k,
+                                               ccl_private float4 *pointX,
+                                               ccl_private float4 *pointY,
+                                               ccl_private float4 *pointZ)
+{
+  const float4 offsetX = make_float4(-1.0f, 0.0f, 1.0f, 2.0f);
+
+  float4 hashX, hashY, hashZ;
+  hash_float4_3_to_float4_3(make_float4(cellPosition.x) + offsetX,
+                            make_float4(cellPosition.y + j),
+                            make_float4(cellPosition.z + k),
+                            &hashX,
+                            &hashY,
+                            &hashZ);
+
+  *pointX = offsetX + hashX * params.randomness;
+  *pointY = make_float4(float(j)) + hashY * params.randomness;
+  *pointZ = make_float4(float(k)) + hashZ * params.randomness;
+
+  const float4 dx = fabs(*pointX - make_float4(localPosition.x));
+  const float4 dy = fabs(*pointY - make_float4(localPosition.y));
+  const float4 dz = fabs(*pointZ - make_float4(localPosition.z));
+
+  if (params.metric == NODE_VORONOI_EUCLIDEAN) {
+    return sqrt(dx * dx + dy * dy + dz * dz);
+  }
+  else if (params.metric == NODE_VORONOI_MANHATTAN) {
+    return dx + dy + dz;
+  }
+  else if (params.metric == NODE_VORONOI_CHEBYCHEV) {
+    return max(max(dx, dy), dz);
+  }
+  else if (params.metric == NODE_VORONOI_MINKOWSKI) {
+    return power(power(dx, params.exponent) + power(dy, params.exponent) +
+                     power(dz, params.exponent),
+                 1.0f / params.exponent);
+  }
+  else {
+    return zero_float4();
+  }
+}
+#endif
+
 ccl_device VoronoiOutput voronoi_f1(ccl_private const VoronoiParams &params, const float3 coord)
 {
   float3 cellPosition = floor(coord);
@@ -439,11 +495,21 @@ ccl_device VoronoiOutput voronoi_f1(ccl_private const VoronoiParams &params, con
   float3 targetPosition = make_float3(0.0f, 0.0f, 0.0f);
   for (int k = -1; k <= 1; k++) {
     for (int j = -1; j <= 1; j++) {
+#ifdef __KERNEL_SSE__
+      float4 pointX, pointY, pointZ;
+      const float4 distances = voronoi_row_distances(
+          params, cellPosition, localPosition, j, k, &pointX, &pointY, &pointZ);
+#endif
       for (int i = -1; i <= 1; i++) {
         float3 cellOffset = make_float3(i, j, k);
+#ifdef __KERNEL_SSE__
+        float3 pointPosition = make_float3(pointX[i + 1], pointY[i + 1], pointZ[i + 1]);
+        float distanceToPoint = distances[i + 1];
+#else
         float3 pointPosition = cellOffset + hash_float3_to_float3(cellPosition + cellOffset) *
                                                 params.randomness;
         float distanceToPoint = voronoi_distance(pointPosition, localPosition, params);
+#endif
         if (distanceToPoint < minDistance) {
           targetOffset = cellOffset;
           minDistance = distanceToPoint;
@@ -508,11 +574,21 @@ ccl_device VoronoiOutput voronoi_f2(ccl_private const VoronoiParams &params, con
   float3 positionF2 = make_float3(0.0f, 0.0f, 0.0f);
   for (int k = -1; k <= 1; k++) {
     for (int j = -1; j <= 1; j++) {
+#ifdef __KERNEL_SSE__
+      float4 pointX, pointY, pointZ;
+      const float4 distances = voronoi_row_distances(
+          params, cellPosition, localPosition, j, k, &pointX, &pointY, &pointZ);
+#endif
       for (int i = -1; i <= 1; i++) {
         float3 cellOffset = make_float3(i, j, k);
+#ifdef __KERNEL_SSE__
+        float3 pointPosition = make_float3(pointX[i + 1], pointY[i + 1], pointZ[i + 1]);
+        float distanceToPoint = distances[i + 1];
+#else
         float3 pointPosition = cellOffset + hash_float3_to_float3(cellPosition + cellOffset) *
                                                 params.randomness;
         float distanceToPoint = voronoi_distance(pointPosition, localPosition, params);
+#endif
         if (distanceToPoint < distanceF1) {
           distanceF2 = distanceF1;
           distanceF1 = distanceToPoint;
@@ -18,11 +18,21 @@ CCL_NAMESPACE_BEGIN
     ProfilingWithShaderHelper profiling_helper((ProfilingState *)&kg->profiler, event)
 #  define PROFILING_SHADER(object, shader) \
     profiling_helper.set_shader(object, (shader)&SHADER_MASK);
+#  define PROFILING_INIT_FOR_SVM(kg) \
+    ProfilingWithSVMNodeHelper profiling_svm_helper((ProfilingState *)&kg->profiler)
+#  define PROFILING_SVM_NODE(node) profiling_svm_helper.set_svm_node(node)
+#  define PROFILING_IMAGE_FETCH(kg, image, bytes) \
+    if (kg->profiler.active) { \
+      ((ProfilingState *)&kg->profiler)->add_image_fetch(image, bytes); \
+    }
 #else
 #  define PROFILING_INIT(kg, event)
 #  define PROFILING_EVENT(event)
 #  define PROFILING_INIT_FOR_SHADER(kg, event)
 #  define PROFILING_SHADER(object, shader)
+#  define PROFILING_INIT_FOR_SVM(kg)
+#  define PROFILING_SVM_NODE(node)
+#  define PROFILING_IMAGE_FETCH(kg, image, bytes)
 #endif /* !__KERNEL_GPU__ */
 
 CCL_NAMESPACE_END
@@ -16,6 +16,7 @@
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/tbb.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -455,14 +456,14 @@ bool AlembicObject::has_data_loaded() const
   return data_loaded;
 }
 
-void AlembicObject::load_data_in_cache(CachedData &cached_data,
+bool AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        IPolyMeshSchema &schema,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
   if (instance_of) {
-    return;
+    return false;
   }
 
   cached_data.clear();
@@ -475,40 +476,40 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.face_indices = schema.getFaceIndicesProperty();
   data.normals = schema.getNormalsParam();
   data.num_samples = schema.getNumSamples();
-  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
+  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, load_used_shaders);
 
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
-    return;
+    return false;
   }
 
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), load_requested_attributes, progress);
 
   if (progress.get_cancel()) {
-    return;
+    return false;
   }
 
   cached_data.invalidate_last_loaded_time(true);
-  data_loaded = true;
+  return true;
 }
 
-void AlembicObject::load_data_in_cache(CachedData &cached_data,
+bool AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        ISubDSchema &schema,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
   if (instance_of) {
-    return;
+    return false;
   }
 
   cached_data.clear();
 
-  if (this->get_ignore_subdivision()) {
+  if (load_ignore_subdivision) {
     PolyMeshSchemaData data;
     data.topology_variance = schema.getTopologyVariance();
     data.time_sampling = schema.getTimeSampling();
@@ -517,22 +518,21 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
     data.face_indices = schema.getFaceIndicesProperty();
     data.num_samples = schema.getNumSamples();
     data.velocities = schema.getVelocitiesProperty();
-    data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
+    data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, load_used_shaders);
 
     read_geometry_data(proc, cached_data, data, progress);
 
     if (progress.get_cancel()) {
-      return;
+      return false;
     }
 
     /* Use the schema as the base compound property to also be able to look for top level
      * properties. */
     read_attributes(
-        proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+        proc, cached_data, schema, schema.getUVsParam(), load_requested_attributes, progress);
 
     cached_data.invalidate_last_loaded_time(true);
-    data_loaded = true;
-    return;
+    return true;
   }
 
   SubDSchemaData data;
@@ -553,31 +553,31 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.holes = schema.getHolesProperty();
   data.subdivision_scheme = schema.getSubdivisionSchemeProperty();
   data.velocities = schema.getVelocitiesProperty();
-  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, get_used_shaders());
+  data.shader_face_sets = parse_face_sets_for_shader_assignment(schema, load_used_shaders);
 
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
-    return;
+    return false;
   }
 
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), load_requested_attributes, progress);
 
   cached_data.invalidate_last_loaded_time(true);
-  data_loaded = true;
+  return true;
 }
 
-void AlembicObject::load_data_in_cache(CachedData &cached_data,
+bool AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        const ICurvesSchema &schema,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
   if (instance_of) {
-    return;
+    return false;
   }
 
   cached_data.clear();
@@ -594,32 +594,32 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.topology_variance = schema.getTopologyVariance();
   data.num_samples = schema.getNumSamples();
   data.num_vertices = schema.getNumVerticesProperty();
-  data.default_radius = proc->get_default_radius();
-  data.radius_scale = get_radius_scale();
+  data.default_radius = cached_data.load_default_radius;
+  data.radius_scale = load_radius_scale;
 
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
-    return;
+    return false;
   }
 
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
   read_attributes(
-      proc, cached_data, schema, schema.getUVsParam(), get_requested_attributes(), progress);
+      proc, cached_data, schema, schema.getUVsParam(), load_requested_attributes, progress);
 
   cached_data.invalidate_last_loaded_time(true);
-  data_loaded = true;
+  return true;
 }
 
-void AlembicObject::load_data_in_cache(CachedData &cached_data,
+bool AlembicObject::load_data_in_cache(CachedData &cached_data,
                                        AlembicProcedural *proc,
                                        const IPointsSchema &schema,
                                        Progress &progress)
 {
   /* Only load data for the original Geometry. */
   if (instance_of) {
-    return;
+    return false;
   }
 
   cached_data.clear();
@@ -630,21 +630,21 @@ void AlembicObject::load_data_in_cache(CachedData &cached_data,
   data.velocities = schema.getVelocitiesProperty();
   data.time_sampling = schema.getTimeSampling();
   data.num_samples = schema.getNumSamples();
-  data.default_radius = proc->get_default_radius();
-  data.radius_scale = get_radius_scale();
+  data.default_radius = cached_data.load_default_radius;
+  data.radius_scale = load_radius_scale;
 
   read_geometry_data(proc, cached_data, data, progress);
 
   if (progress.get_cancel()) {
-    return;
+    return false;
   }
 
   /* Use the schema as the base compound property to also be able to look for top level properties.
    */
-  read_attributes(proc, cached_data, schema, {}, get_requested_attributes(), progress);
+  read_attributes(proc, cached_data, schema, {}, load_requested_attributes, progress);
 
   cached_data.invalidate_last_loaded_time(true);
-  data_loaded = true;
+  return true;
 }
 
 void AlembicObject::setup_transform_cache(CachedData &cached_data, float scale)
@@ -788,10 +788,18 @@ AlembicProcedural::AlembicProcedural() : Procedural(get_node_type())
 {
   objects_loaded = false;
   scene_ = nullptr;
+  cache_start_frame_ = 0.0f;
+  cache_end_frame_ = -1.0f;
+  prefetch_start_frame_ = 0.0f;
+  prefetch_end_frame_ = -1.0f;
 }
 
 AlembicProcedural::~AlembicProcedural()
 {
+  /* Stop loading in the background before the objects are deleted. */
+  prefetch_progress_.set_cancel("Cancelled");
+  prefetch_pool_.wait_work();
+
   ccl::set<Geometry *> geometries_set;
   ccl::set<Object *> objects_set;
   ccl::set<AlembicObject *> abc_objects_set;
@@ -866,9 +874,14 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     return;
   }
 
+  /* The objects and the archive must not be modified while they are read in the background. */
+  finish_prefetch();
+
   if (!archive.valid() || filepath_is_modified() || layers_is_modified()) {
     Alembic::AbcCoreFactory::IFactory factory;
     factory.setPolicy(Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+    /* Allow objects to be read from multiple threads without serializing file access. */
+    factory.setOgawaNumStreams(TaskScheduler::max_concurrency());
 
     std::vector<std::string> filenames;
     filenames.push_back(filepath.c_str());
@@ -911,16 +924,7 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
-  if (use_prefetch_is_modified()) {
-    if (!use_prefetch) {
-      for (Node *node : objects) {
-        AlembicObject *object = static_cast<AlembicObject *>(node);
-        object->clear_cache();
-      }
-    }
-  }
-
-  if (prefetch_cache_size_is_modified()) {
+  if (prefetch_cache_size_is_modified() && use_prefetch) {
     /* Check whether the current memory usage fits in the new requested size,
      * abort the render if it is any higher. */
     size_t memory_used = 0ul;
@@ -1479,12 +1483,191 @@ void AlembicProcedural::walk_hierarchy(
   }
 }
 
+bool AlembicProcedural::load_object_data(AlembicObject *object,
+                                         CachedData &cached_data,
+                                         Progress &progress)
+{
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+    IPolyMeshSchema schema = polymesh.getSchema();
+    return object->load_data_in_cache(cached_data, this, schema, progress);
+  }
+  if (object->schema_type == AlembicObject::CURVES) {
+    ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
+    ICurvesSchema schema = curves.getSchema();
+    return object->load_data_in_cache(cached_data, this, schema, progress);
+  }
+  if (object->schema_type == AlembicObject::POINTS) {
+    IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
+    IPointsSchema schema = points.getSchema();
+    return object->load_data_in_cache(cached_data, this, schema, progress);
+  }
+  if (object->schema_type == AlembicObject::SUBD) {
+    ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+    ISubDSchema schema = subd_mesh.getSchema();
+    return object->load_data_in_cache(cached_data, this, schema, progress);
+  }
+
+  return false;
+}
+
+void AlembicProcedural::finish_prefetch()
+{
+  if (prefetch_end_frame_ < prefetch_start_frame_) {
+    return;
+  }
+
+  /* Only wait for the data if it will be used for the current frame, and neither the archive,
+   * the objects, nor any of the sockets the data was loaded with changed. */
+  bool use_prefetched_data = !use_prefetch && frame >= prefetch_start_frame_ &&
+                             frame < prefetch_end_frame_ + 1.0f && !filepath_is_modified() &&
+                             !layers_is_modified() && !objects_is_modified() &&
+                             !frame_rate_is_modified() && !scale_is_modified() &&
+                             !default_radius_is_modified();
+
+  if (use_prefetched_data) {
+    for (Node *node : objects) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      if (object->ignore_subdivision_is_modified() || object->radius_scale_is_modified()) {
+        use_prefetched_data = false;
+        break;
+      }
+    }
+  }
+
+  if (!use_prefetched_data) {
+    prefetch_progress_.set_cancel("Cancelled");
+  }
+
+  prefetch_pool_.wait_work();
+
+  if (prefetch_progress_.get_cancel()) {
+    prefetch_progress_.reset();
+
+    for (Node *node : objects) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      object->prefetched_data_.clear();
+      object->prefetched_data_loaded = false;
+    }
+
+    prefetch_start_frame_ = 0.0f;
+    prefetch_end_frame_ = -1.0f;
+  }
+}
+
+void AlembicProcedural::start_prefetch(size_t memory_used)
+{
+  if (use_prefetch || cache_end_frame_ >= end_frame) {
+    return;
+  }
+
+  /* Use the memory of the currently cached frames as estimate for the following frames, and give
+   * half of the cache size to each of the cached and prefetched frames. */
+  const size_t num_cached_frames = static_cast<size_t>(cache_end_frame_ - cache_start_frame_) + 1;
+  const size_t memory_per_frame = max(memory_used / num_cached_frames, size_t(1));
+  const size_t num_frames = max(get_prefetch_cache_size_in_bytes() / 2 / memory_per_frame,
+                                size_t(1));
+
+  prefetch_start_frame_ = cache_end_frame_ + 1.0f;
+  prefetch_end_frame_ = min(prefetch_start_frame_ + static_cast<float>(num_frames - 1),
+                            end_frame);
+
+  const float object_scale = scale;
+
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+
+    if (object->instance_of || object->schema_type == AlembicObject::INVALID) {
+      continue;
+    }
+
+    object->prefetched_data_.load_start_frame = prefetch_start_frame_;
+    object->prefetched_data_.load_end_frame = prefetch_end_frame_;
+    object->prefetched_data_.load_frame_rate = frame_rate;
+    object->prefetched_data_.load_default_radius = default_radius;
+
+    prefetch_pool_.push([this, object, object_scale]() {
+      if (prefetch_progress_.get_cancel()) {
+        return;
+      }
+
+      if (load_object_data(object, object->prefetched_data_, prefetch_progress_)) {
+        object->setup_transform_cache(object->prefetched_data_, object_scale);
+        object->prefetched_data_loaded = true;
+      }
+    });
+  }
+
+  VLOG_WORK << "AlembicProcedural prefetching frames " << prefetch_start_frame_ << " to "
+            << prefetch_end_frame_;
+}
+
 void AlembicProcedural::build_caches(Progress &progress)
 {
-  size_t memory_used = 0;
+  /* Determine the frames to hold in the caches. */
+  float new_cache_start_frame = start_frame;
+  float new_cache_end_frame = end_frame;
+
+  if (!use_prefetch) {
+    if (frame >= cache_start_frame_ && frame < cache_end_frame_ + 1.0f) {
+      new_cache_start_frame = cache_start_frame_;
+      new_cache_end_frame = cache_end_frame_;
+    }
+    else if (frame >= prefetch_start_frame_ && frame < prefetch_end_frame_ + 1.0f) {
+      /* Use the data loaded in the background, objects whose loading did not finish are loaded
+       * again below. */
+      for (Node *node : objects) {
+        AlembicObject *object = static_cast<AlembicObject *>(node);
+
+        if (object->prefetched_data_loaded) {
+          std::swap(object->cached_data_, object->prefetched_data_);
+          object->data_loaded = true;
+        }
+        else {
+          object->clear_cache();
+        }
+
+        object->prefetched_data_.clear();
+        object->prefetched_data_loaded = false;
+      }
+
+      cache_start_frame_ = new_cache_start_frame = prefetch_start_frame_;
+      cache_end_frame_ = new_cache_end_frame = prefetch_end_frame_;
+    }
+    else {
+      new_cache_start_frame = new_cache_end_frame = floorf(frame);
+    }
+
+    prefetch_start_frame_ = 0.0f;
+    prefetch_end_frame_ = -1.0f;
+  }
+
+  if (new_cache_start_frame != cache_start_frame_ || new_cache_end_frame != cache_end_frame_) {
+    for (Node *node : objects) {
+      AlembicObject *object = static_cast<AlembicObject *>(node);
+      object->clear_cache();
+    }
+
+    cache_start_frame_ = new_cache_start_frame;
+    cache_end_frame_ = new_cache_end_frame;
+  }
 
+  /* Copy the sockets used for loading, as loading may happen in the background later. */
   for (Node *node : objects) {
     AlembicObject *object = static_cast<AlembicObject *>(node);
+    object->load_used_shaders = object->get_used_shaders();
+    object->load_requested_attributes = object->get_requested_attributes();
+    object->load_ignore_subdivision = object->get_ignore_subdivision();
+    object->load_radius_scale = object->get_radius_scale();
+    object->get_cached_data().load_start_frame = cache_start_frame_;
+    object->get_cached_data().load_end_frame = cache_end_frame_;
+    object->get_cached_data().load_frame_rate = frame_rate;
+    object->get_cached_data().load_default_radius = default_radius;
+  }
+
+  /* Read the objects in parallel, archive reads are the main cost here. */
+  parallel_for(size_t(0), objects.size(), [&](size_t i) {
+    AlembicObject *object = static_cast<AlembicObject *>(objects[i]);
 
     if (progress.get_cancel()) {
       return;
@@ -1492,9 +1675,7 @@ void AlembicProcedural::build_caches(Progress &progress)
 
     if (object->schema_type == AlembicObject::POLY_MESH) {
       if (!object->has_data_loaded()) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->data_loaded = load_object_data(object, object->get_cached_data(), progress);
       }
       else if (object->need_shader_update) {
         IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
@@ -1503,33 +1684,22 @@ void AlembicProcedural::build_caches(Progress &progress)
                         object->get_cached_data(),
                         schema,
                         schema.getUVsParam(),
-                        object->get_requested_attributes(),
+                        object->load_requested_attributes,
                         progress);
       }
     }
-    else if (object->schema_type == AlembicObject::CURVES) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified())
-      {
-        ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
-        ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-    }
-    else if (object->schema_type == AlembicObject::POINTS) {
+    else if (object->schema_type == AlembicObject::CURVES ||
+             object->schema_type == AlembicObject::POINTS)
+    {
       if (!object->has_data_loaded() || default_radius_is_modified() ||
           object->radius_scale_is_modified())
       {
-        IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
-        IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->data_loaded = load_object_data(object, object->get_cached_data(), progress);
       }
     }
     else if (object->schema_type == AlembicObject::SUBD) {
       if (!object->has_data_loaded()) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+        object->data_loaded = load_object_data(object, object->get_cached_data(), progress);
       }
       else if (object->need_shader_update) {
         ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
@@ -1538,7 +1708,7 @@ void AlembicProcedural::build_caches(Progress &progress)
                         object->get_cached_data(),
                         schema,
                         schema.getUVsParam(),
-                        object->get_requested_attributes(),
+                        object->load_requested_attributes,
                         progress);
       }
     }
@@ -1546,18 +1716,29 @@ void AlembicProcedural::build_caches(Progress &progress)
     if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
       object->setup_transform_cache(object->get_cached_data(), scale);
     }
+  });
+
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  size_t memory_used = 0;
 
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
     memory_used += object->get_cached_data().memory_used();
+  }
 
-    if (use_prefetch) {
-      if (memory_used > get_prefetch_cache_size_in_bytes()) {
-        progress.set_error("Error: Alembic Procedural memory limit reached");
-        return;
-      }
+  if (use_prefetch) {
+    if (memory_used > get_prefetch_cache_size_in_bytes()) {
+      progress.set_error("Error: Alembic Procedural memory limit reached");
+      return;
     }
   }
 
   VLOG_WORK << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
+
+  start_prefetch(memory_used);
 }
 
 CCL_NAMESPACE_END
@@ -7,7 +7,9 @@
 #include "graph/node.h"
 #include "scene/attribute.h"
 #include "scene/procedural.h"
+#include "util/progress.h"
 #include "util/set.h"
+#include "util/task.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -21,7 +23,6 @@ CCL_NAMESPACE_BEGIN
 class AlembicProcedural;
 class Geometry;
 class Object;
-class Progress;
 class Shader;
 
 using MatrixSampleMap = std::map<Alembic::Abc::chrono_t, Alembic::Abc::M44d>;
@@ -278,9 +279,21 @@ template<typename T> class DataStore {
  private:
   const TimeIndexPair &get_index_for_time(double time) const
   {
-    std::pair<size_t, Alembic::Abc::chrono_t> index_pair;
-    index_pair = time_sampling.getNearIndex(time, index_data_map.size());
-    return index_data_map[index_pair.first];
+    /* The entries are in chronological order but may only cover a window of the animation, so
+     * look up the entry nearest to the time instead of indexing with the time sampling. */
+    auto it = std::lower_bound(
+        index_data_map.begin(),
+        index_data_map.end(),
+        time,
+        [](const TimeIndexPair &pair, double time) { return pair.time < time; });
+
+    if (it == index_data_map.end()) {
+      return index_data_map.back();
+    }
+    if (it != index_data_map.begin() && (time - (it - 1)->time) <= (it->time - time)) {
+      return *(it - 1);
+    }
+    return *it;
   }
 };
 
@@ -332,6 +345,16 @@ struct CachedData {
 
   vector<CachedAttribute> attributes{};
 
+  /* Range of frames to load data for, either the entire animation when prefetching or a window of
+   * frames around the current one. Not reset when clearing the data. */
+  float load_start_frame = 0.0f;
+  float load_end_frame = 0.0f;
+
+  /* Copies of the procedural sockets used for loading, taken before loading since the sockets may
+   * be modified while data is loaded in the background. Not reset when clearing the data. */
+  float load_frame_rate = 24.0f;
+  float load_default_radius = 0.01f;
+
   void clear();
 
   CachedAttribute &add_attribute(const ustring &name,
@@ -387,19 +410,21 @@ class AlembicObject : public Node {
   void set_object(Object *object);
   Object *get_object();
 
-  void load_data_in_cache(CachedData &cached_data,
+  /* Load the data for the frames set in the cache. Returns false if nothing was loaded because
+   * the object is an instance, or if loading was cancelled. */
+  bool load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           Alembic::AbcGeom::IPolyMeshSchema &schema,
                           Progress &progress);
-  void load_data_in_cache(CachedData &cached_data,
+  bool load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           Alembic::AbcGeom::ISubDSchema &schema,
                           Progress &progress);
-  void load_data_in_cache(CachedData &cached_data,
+  bool load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           const Alembic::AbcGeom::ICurvesSchema &schema,
                           Progress &progress);
-  void load_data_in_cache(CachedData &cached_data,
+  bool load_data_in_cache(CachedData &cached_data,
                           AlembicProcedural *proc,
                           const Alembic::AbcGeom::IPointsSchema &schema,
                           Progress &progress);
@@ -440,6 +465,7 @@ class AlembicObject : public Node {
   void clear_cache()
   {
     cached_data_.clear();
+    data_loaded = false;
   }
 
   Object *object = nullptr;
@@ -448,6 +474,17 @@ class AlembicObject : public Node {
 
   CachedData cached_data_;
 
+  /* Data for the frames following the cached ones, loaded in the background. */
+  CachedData prefetched_data_;
+  bool prefetched_data_loaded = false;
+
+  /* Copies of the sockets used for loading, taken before loading since the sockets may be
+   * modified while data is loaded in the background. */
+  array<Node *> load_used_shaders;
+  AttributeRequestSet load_requested_attributes;
+  bool load_ignore_subdivision = false;
+  float load_radius_scale = 1.0f;
+
   void setup_transform_cache(CachedData &cached_data, float scale);
 
   AttributeRequestSet get_requested_attributes();
@@ -460,13 +497,27 @@ class AlembicObject : public Node {
  *
  * This procedural will load the data set for the entire animation in memory on the first frame,
  * and directly set the data for the new frames on the created Nodes if needed. This allows for
- * faster updates between frames as it avoids reseeking the data on disk.
+ * faster updates between frames as it avoids reseeking the data on disk. Without prefetching, a
+ * window of frames is cached while the following frames are loaded in the background.
+ *
+ * Objects are read from the archive in parallel.
  */
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
   bool objects_loaded;
   Scene *scene_;
 
+  /* Frames held in the caches of the objects. */
+  float cache_start_frame_;
+  float cache_end_frame_;
+
+  /* When not prefetching the entire animation, the frames following the cached ones are loaded in
+   * the background, within the memory limit of the cache. */
+  float prefetch_start_frame_;
+  float prefetch_end_frame_;
+  TaskPool prefetch_pool_;
+  Progress prefetch_progress_;
+
  public:
   NODE_DECLARE
 
@@ -506,8 +557,9 @@ class AlembicProcedural : public Procedural {
   /* Cache controls */
   NODE_SOCKET_API(bool, use_prefetch)
 
-  /* Memory limit for the cache, if the data does not fit within this limit, rendering is aborted.
-   */
+  /* Memory limit for the cache. When prefetching the entire animation, rendering is aborted if the
+   * data does not fit within this limit. Otherwise it limits the number of frames loaded ahead in
+   * the background. */
   NODE_SOCKET_API(int, prefetch_cache_size)
 
   AlembicProcedural();
@@ -564,6 +616,15 @@ class AlembicProcedural : public Procedural {
 
   void build_caches(Progress &progress);
 
+  /* Load the data of the object in the given cache, for the frames set in the cache. */
+  bool load_object_data(AlembicObject *object, CachedData &cached_data, Progress &progress);
+
+  /* Start loading the frames following the cached ones in the background. */
+  void start_prefetch(size_t memory_used);
+
+  /* Wait for the background loading if it covers the current frame, otherwise cancel it. */
+  void finish_prefetch();
+
   size_t get_prefetch_cache_size_in_bytes() const
   {
     /* prefetch_cache_size is in megabytes, so convert to bytes. */
@@ -25,6 +25,8 @@ DeviceScene::DeviceScene(Device *device)
       tri_patch_uv(device, "tri_patch_uv", MEM_GLOBAL),
       curves(device, "curves", MEM_GLOBAL),
       curve_keys(device, "curve_keys", MEM_GLOBAL),
+      curve_keys_compact(device, "curve_keys_compact", MEM_GLOBAL),
+      curve_key_ranges(device, "curve_key_ranges", MEM_GLOBAL),
       curve_segments(device, "curve_segments", MEM_GLOBAL),
       patches(device, "patches", MEM_GLOBAL),
       points(device, "points", MEM_GLOBAL),
@@ -35,6 +35,8 @@ class DeviceScene {
 
   device_vector<KernelCurve> curves;
   device_vector<float4> curve_keys;
+  device_vector<uint> curve_keys_compact;
+  device_vector<float4> curve_key_ranges;
   device_vector<KernelCurveSegment> curve_segments;
 
   device_vector<uint> patches;
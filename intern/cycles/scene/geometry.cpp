@@ -29,10 +29,12 @@
 #  include "kernel/osl/globals.h"
 #endif
 
+#include "util/atomic.h"
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -529,6 +531,8 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
     if (device_update_flags & DEVICE_CURVE_DATA_NEEDS_REALLOC) {
       dscene->curves.tag_realloc();
       dscene->curve_keys.tag_realloc();
+      dscene->curve_keys_compact.tag_realloc();
+      dscene->curve_key_ranges.tag_realloc();
       dscene->curve_segments.tag_realloc();
     }
 
@@ -592,6 +596,8 @@ void GeometryManager::device_update_preprocess(Device *device, Scene *scene, Pro
 
   if (device_update_flags & DEVICE_CURVE_DATA_MODIFIED) {
     dscene->curve_keys.tag_modified();
+    dscene->curve_keys_compact.tag_modified();
+    dscene->curve_key_ranges.tag_modified();
     dscene->curves.tag_modified();
     dscene->curve_segments.tag_modified();
   }
@@ -778,7 +784,7 @@ void GeometryManager::device_update(Device *device,
                                    dicing_camera->get_full_height());
     dicing_camera->update(scene);
 
-    size_t i = 0;
+    vector<Mesh *> tess_meshes;
     foreach (Geometry *geom, scene->geometry) {
       if (!(geom->is_modified() && geom->is_mesh())) {
         continue;
@@ -786,26 +792,32 @@ void GeometryManager::device_update(Device *device,
 
       Mesh *mesh = static_cast<Mesh *>(geom);
       if (mesh->need_tesselation()) {
-        string msg = "Tessellating ";
-        if (mesh->name == "")
-          msg += string_printf("%u/%u", (uint)(i + 1), (uint)total_tess_needed);
-        else
-          msg += string_printf(
-              "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
+        tess_meshes.push_back(mesh);
+      }
+    }
 
-        progress.set_status("Updating Mesh", msg);
+    /* Meshes are tessellated in parallel, in addition to patches within each mesh. */
+    uint num_tessellated = 0;
+    parallel_for(size_t(0), tess_meshes.size(), [&](size_t i) {
+      if (progress.get_cancel()) {
+        return;
+      }
 
-        mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
+      Mesh *mesh = tess_meshes[i];
+      const uint index = atomic_fetch_and_inc_uint32(&num_tessellated);
 
-        i++;
+      string msg = "Tessellating ";
+      if (mesh->name == "")
+        msg += string_printf("%u/%u", index + 1, (uint)total_tess_needed);
+      else
+        msg += string_printf("%s %u/%u", mesh->name.c_str(), index + 1, (uint)total_tess_needed);
 
-        if (progress.get_cancel()) {
-          return;
-        }
-      }
-    }
+      progress.set_status("Updating Mesh", msg);
+
+      mesh->subd_params->camera = dicing_camera;
+      DiagSplit dsplit(*mesh->subd_params);
+      mesh->tessellate(&dsplit);
+    });
 
     if (progress.get_cancel()) {
       return;
@@ -872,12 +884,14 @@ void GeometryManager::device_update(Device *device,
       }
     });
 
+    vector<Mesh *> displace_meshes;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified()) {
         if (geom->is_mesh()) {
           Mesh *mesh = static_cast<Mesh *>(geom);
-          if (displace(device, scene, mesh, progress)) {
-            displacement_done = true;
+          if (mesh->has_true_displacement() && mesh->num_triangles() != 0) {
+            displace_meshes.push_back(mesh);
           }
         }
         else if (geom->geometry_type == Geometry::HAIR) {
@@ -898,6 +912,11 @@ void GeometryManager::device_update(Device *device,
         return;
       }
     }
+
+    /* Displacement of all meshes is evaluated in a single batch. */
+    if (!displace_meshes.empty() && displace(device, scene, displace_meshes, progress)) {
+      displacement_done = true;
+    }
   }
 
   if (progress.get_cancel()) {
@@ -1047,6 +1066,8 @@ void GeometryManager::device_update(Device *device,
   dscene->tri_patch_uv.clear_modified();
   dscene->curves.clear_modified();
   dscene->curve_keys.clear_modified();
+  dscene->curve_keys_compact.clear_modified();
+  dscene->curve_key_ranges.clear_modified();
   dscene->curve_segments.clear_modified();
   dscene->points.clear_modified();
   dscene->points_shader.clear_modified();
@@ -1077,6 +1098,8 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool forc
   dscene->tri_patch_uv.free_if_need_realloc(force_free);
   dscene->curves.free_if_need_realloc(force_free);
   dscene->curve_keys.free_if_need_realloc(force_free);
+  dscene->curve_keys_compact.free_if_need_realloc(force_free);
+  dscene->curve_key_ranges.free_if_need_realloc(force_free);
   dscene->curve_segments.free_if_need_realloc(force_free);
   dscene->points.free_if_need_realloc(force_free);
   dscene->points_shader.free_if_need_realloc(force_free);
@@ -247,7 +247,10 @@ class GeometryManager {
   void collect_statistics(const Scene *scene, RenderStats *stats);
 
  protected:
-  bool displace(Device *device, Scene *scene, Mesh *mesh, Progress &progress);
+  bool displace(Device *device,
+                Scene *scene,
+                const vector<Mesh *> &meshes,
+                Progress &progress);
 
   void create_volume_mesh(const Scene *scene, Volume *volume, Progress &progress);
 
@@ -36,7 +36,7 @@
 
 CCL_NAMESPACE_BEGIN
 
-void GeometryManager::device_update_mesh(Device *,
+void GeometryManager::device_update_mesh(Device *device,
                                          DeviceScene *dscene,
                                          Scene *scene,
                                          Progress &progress)
@@ -144,11 +144,29 @@ void GeometryManager::device_update_mesh(Device *,
   if (curve_segment_size != 0) {
     progress.set_status("Updating Mesh", "Copying Curves to device");
 
-    float4 *curve_keys = dscene->curve_keys.alloc(curve_key_size);
+    /* Compact keys take 8 bytes per key and 16 bytes per curve, instead of 16 bytes per key.
+     * They are only used with BVH2, which intersects curves with the keys decoded by the kernel.
+     * Other acceleration structures intersect the full precision keys they were built from, and
+     * shading must match them. */
+    const BVHLayout bvh_layout = BVHParams::best_bvh_layout(
+        scene->params.bvh_layout, device->get_bvh_layout_mask(dscene->data.kernel_features));
+    const bool use_compact_curves = scene->params.use_compact_curves &&
+                                    bvh_layout == BVH_LAYOUT_BVH2;
+    dscene->data.bvh.use_compact_curves = use_compact_curves;
+
+    float4 *curve_keys = (use_compact_curves) ? nullptr :
+                                                dscene->curve_keys.alloc(curve_key_size);
+    uint *curve_keys_compact = (use_compact_curves) ?
+                                   dscene->curve_keys_compact.alloc(curve_key_size * 2) :
+                                   nullptr;
+    float4 *curve_key_ranges = (use_compact_curves) ? dscene->curve_key_ranges.alloc(curve_size) :
+                                                      nullptr;
     KernelCurve *curves = dscene->curves.alloc(curve_size);
     KernelCurveSegment *curve_segments = dscene->curve_segments.alloc(curve_segment_size);
 
     const bool copy_all_data = dscene->curve_keys.need_realloc() ||
+                               dscene->curve_keys_compact.need_realloc() ||
+                               dscene->curve_key_ranges.need_realloc() ||
                                dscene->curves.need_realloc() ||
                                dscene->curve_segments.need_realloc();
 
@@ -165,16 +183,21 @@ void GeometryManager::device_update_mesh(Device *,
           continue;
         }
 
-        hair->pack_curves(scene,
-                          &curve_keys[hair->curve_key_offset],
-                          &curves[hair->prim_offset],
-                          &curve_segments[hair->curve_segment_offset]);
+        hair->pack_curves(
+            scene,
+            (curve_keys) ? &curve_keys[hair->curve_key_offset] : nullptr,
+            (curve_keys_compact) ? &curve_keys_compact[hair->curve_key_offset * 2] : nullptr,
+            (curve_key_ranges) ? &curve_key_ranges[hair->prim_offset] : nullptr,
+            &curves[hair->prim_offset],
+            &curve_segments[hair->curve_segment_offset]);
         if (progress.get_cancel())
           return;
       }
     }
 
     dscene->curve_keys.copy_to_device_if_modified();
+    dscene->curve_keys_compact.copy_to_device_if_modified();
+    dscene->curve_key_ranges.copy_to_device_if_modified();
     dscene->curves.copy_to_device_if_modified();
     dscene->curve_segments.copy_to_device_if_modified();
   }
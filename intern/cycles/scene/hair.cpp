@@ -480,15 +480,73 @@ void Hair::apply_transform(const Transform &tfm, const bool apply_to_motion)
   }
 }
 
+/* Compact curve keys, decoding must match curve_key() in the kernel. */
+static float4 curve_key_range(const float3 *keys, const int num_keys)
+{
+  BoundBox bounds = BoundBox::empty;
+  for (int i = 0; i < num_keys; i++) {
+    bounds.grow_safe(keys[i]);
+  }
+
+  if (!bounds.valid()) {
+    return zero_float4();
+  }
+
+  const float scale = reduce_max(bounds.size()) / 65535.0f;
+  return make_float4(bounds.min.x, bounds.min.y, bounds.min.z, scale);
+}
+
+static uint curve_key_quantize(const float value, const float origin, const float inv_scale)
+{
+  return (uint)(clamp((value - origin) * inv_scale, 0.0f, 65535.0f) + 0.5f);
+}
+
+static uint curve_key_quantize_radius(const float radius)
+{
+  /* Truncate to the upper 16 bits, so the radius never grows. */
+  return __float_as_uint(max(radius, 0.0f)) >> 16;
+}
+
+static void curve_key_encode(const float4 range,
+                             const float3 key,
+                             const float radius,
+                             uint *compact)
+{
+  /* Shrink the radius by the largest position error, so that the decoded curve stays inside the
+   * original one and bounds computed from the original keys remain conservative. */
+  const float position_error = range.w * 0.5f * M_SQRT3_F;
+  const float inv_scale = (range.w > 0.0f) ? 1.0f / range.w : 0.0f;
+  compact[0] = curve_key_quantize(key.x, range.x, inv_scale) |
+               (curve_key_quantize(key.y, range.y, inv_scale) << 16);
+  compact[1] = curve_key_quantize(key.z, range.z, inv_scale) |
+               (min(curve_key_quantize_radius(radius - position_error), 0x7F7Fu) << 16);
+}
+
 void Hair::pack_curves(Scene *scene,
                        float4 *curve_key_co,
+                       uint *curve_key_compact,
+                       float4 *curve_key_range,
                        KernelCurve *curves,
                        KernelCurveSegment *curve_segments)
 {
   size_t curve_keys_size = curve_keys.size();
 
   /* pack curve keys */
-  if (curve_keys_size) {
+  if (curve_keys_size && curve_key_compact) {
+    const float3 *keys_ptr = curve_keys.data();
+    const float *radius_ptr = curve_radius.data();
+
+    for (size_t i = 0; i < num_curves(); i++) {
+      const Curve curve = get_curve(i);
+      const float4 range = curve_key_range(keys_ptr + curve.first_key, curve.num_keys);
+      curve_key_range[i] = range;
+
+      for (int k = curve.first_key; k < curve.first_key + curve.num_keys; k++) {
+        curve_key_encode(range, keys_ptr[k], radius_ptr[k], &curve_key_compact[k * 2]);
+      }
+    }
+  }
+  else if (curve_keys_size) {
     float3 *keys_ptr = curve_keys.data();
     float *radius_ptr = curve_radius.data();
 
@@ -136,9 +136,16 @@ class Hair : public Geometry {
   /* UDIM */
   void get_uv_tiles(ustring map, unordered_set<int> &tiles) override;
 
-  /* BVH */
+  /* BVH
+   *
+   * Either curve_key_co is filled in, or the compact curve_key_compact and curve_key_range.
+   * Compact key positions are quantized to 16 bits per axis within the bounds of their curve, and
+   * radii are stored as the upper 16 bits of their float. The curve keys themselves are left
+   * unchanged, acceleration structures are still built from them. */
   void pack_curves(Scene *scene,
                    float4 *curve_key_co,
+                   uint *curve_key_compact,
+                   float4 *curve_key_range,
                    KernelCurve *curve,
                    KernelCurveSegment *curve_segments);
 
@@ -942,6 +942,25 @@ void ImageManager::collect_statistics(RenderStats *stats)
   }
 }
 
+void ImageManager::collect_profiling(RenderStats *stats, Profiler &prof)
+{
+  for (size_t slot = 0; slot < images.size(); slot++) {
+    const Image *image = images[slot];
+    if (!image) {
+      continue;
+    }
+    const uint64_t bytes = prof.get_image_bytes(slot);
+    if (bytes != 0) {
+      stats->image_fetches.add_entry(NamedSizeEntry(image->loader->name(), bytes));
+    }
+  }
+}
+
+int ImageManager::get_num_image_slots() const
+{
+  return images.size();
+}
+
 void ImageManager::tag_update()
 {
   need_update_ = true;
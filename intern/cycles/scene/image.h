@@ -23,6 +23,7 @@ class ImageHandle;
 class ImageKey;
 class ImageMetaData;
 class ImageManager;
+class Profiler;
 class Progress;
 class RenderStats;
 class Scene;
@@ -190,6 +191,9 @@ class ImageManager {
   bool set_animation_frame_update(int frame);
 
   void collect_statistics(RenderStats *stats);
+  void collect_profiling(RenderStats *stats, Profiler &prof);
+
+  int get_num_image_slots() const;
 
   void tag_update();
 
@@ -148,6 +148,7 @@ NODE_DEFINE(Integrator)
               "Denoiser Prefilter",
               denoiser_prefilter_enum,
               DENOISER_PREFILTER_ACCURATE);
+  SOCKET_INT(denoise_max_memory, "Denoiser Max Memory", 0);
 
   return type;
 }
@@ -408,6 +409,8 @@ DenoiseParams Integrator::get_denoise_params() const
 
   denoise_params.prefilter = denoiser_prefilter;
 
+  denoise_params.max_memory = denoise_max_memory;
+
   return denoise_params;
 }
 
@@ -465,8 +465,31 @@ struct LightTreeFlatten {
 
   /* Map from instance node to its node index. */
   std::unordered_map<LightTreeNode *, int> instances;
+
+  /* Instance nodes which took over the subtree of their reference node while flattening. */
+  struct SwappedInstance {
+    LightTreeNode *instance_node;
+    LightTreeNode *reference_node;
+    int type;
+  };
+  vector<SwappedInstance> swapped_instances;
 };
 
+/* Undo the changes made to the instance nodes while flattening, so that the tree can be refit
+ * and flattened again. */
+static void light_tree_flatten_restore_instances(LightTreeFlatten &flatten)
+{
+  for (auto it = flatten.swapped_instances.rbegin(); it != flatten.swapped_instances.rend(); ++it)
+  {
+    it->instance_node->type = it->type;
+    if (it->instance_node != it->reference_node) {
+      std::swap(it->instance_node->type, it->reference_node->type);
+      std::swap(it->instance_node->variant_type, it->reference_node->variant_type);
+    }
+  }
+  flatten.swapped_instances.clear();
+}
+
 static void light_tree_node_copy_to_device(KernelLightTreeNode &knode,
                                            const LightTreeNode &node,
                                            const int left_child,
@@ -580,6 +603,7 @@ static void light_tree_leaf_emitters_copy_and_flatten(LightTreeFlatten &flatten,
           std::swap(instance_node->type, reference_node->type);
           std::swap(instance_node->variant_type, reference_node->variant_type);
         }
+        flatten.swapped_instances.push_back({instance_node, reference_node, instance_node->type});
         instance_node->type &= ~LIGHT_TREE_INSTANCE;
       }
 
@@ -777,49 +801,60 @@ void LightManager::device_update_tree(Device *,
   KernelIntegrator *kintegrator = &dscene->data.integrator;
 
   if (!kintegrator->use_light_tree) {
+    light_tree.reset();
     return;
   }
 
-  /* Update light tree. */
-  progress.set_status("Updating Lights", "Computing tree");
+  /* Update light tree. Changes to the strength or transform of lights and emissive objects keep
+   * the structure of the tree, only its measures need to be updated. */
+  const uint32_t refit_flags = LIGHT_MODIFIED | OBJECT_MANAGER | EMISSIVE_OBJECT_MODIFIED;
+  LightTreeNode *root;
+  if (light_tree && (update_flags & ~refit_flags) == 0 && light_tree->can_refit(scene)) {
+    progress.set_status("Updating Lights", "Updating tree");
+    root = light_tree->refit(scene, dscene);
+  }
+  else {
+    progress.set_status("Updating Lights", "Computing tree");
 
-  /* TODO: For now, we'll start with a smaller number of max lights in a node.
-   * More benchmarking is needed to determine what number works best. */
-  LightTree light_tree(scene, dscene, progress, 8);
-  LightTreeNode *root = light_tree.build(scene, dscene);
+    /* TODO: For now, we'll start with a smaller number of max lights in a node.
+     * More benchmarking is needed to determine what number works best. */
+    light_tree = make_unique<LightTree>(scene, dscene, progress, 8);
+    root = light_tree->build(scene, dscene);
+  }
   if (progress.get_cancel()) {
+    light_tree.reset();
     return;
   }
 
   /* Create arguments for recursive tree flatten. */
   LightTreeFlatten flatten;
   flatten.scene = scene;
-  flatten.emitters = light_tree.get_emitters();
+  flatten.emitters = light_tree->get_emitters();
   flatten.object_lookup_offset = dscene->object_lookup_offset.data();
   /* We want to create separate arrays corresponding to triangles and lights,
    * which will be used to index back into the light tree for PDF calculations. */
   flatten.light_array = dscene->light_to_tree.alloc(kintegrator->num_lights);
   flatten.mesh_array = dscene->object_to_tree.alloc(scene->objects.size());
-  flatten.triangle_array = dscene->triangle_to_tree.alloc(light_tree.num_triangles);
+  flatten.triangle_array = dscene->triangle_to_tree.alloc(light_tree->num_triangles);
 
   /* Allocate emitters */
-  const size_t num_emitters = light_tree.num_emitters();
+  const size_t num_emitters = light_tree->num_emitters();
   KernelLightTreeEmitter *kemitters = dscene->light_tree_emitters.alloc(num_emitters);
 
   /* Update integrator state. */
   kintegrator->use_direct_light = num_emitters > 0;
 
   /* Test if light linking is used. */
-  const bool use_light_linking = root && (light_tree.light_link_receiver_used != 1);
+  const bool use_light_linking = root && (light_tree->light_link_receiver_used != 1);
   KernelLightLinkSet *klight_link_sets = dscene->data.light_link_sets;
   memset(klight_link_sets, 0, sizeof(dscene->data.light_link_sets));
 
-  VLOG_INFO << "Use light tree with " << num_emitters << " emitters and " << light_tree.num_nodes
+  VLOG_INFO << "Use light tree with " << num_emitters << " emitters and " << light_tree->num_nodes
             << " nodes.";
 
   if (!use_light_linking) {
     /* Regular light tree without linking. */
-    KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(light_tree.num_nodes);
+    KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(light_tree->num_nodes);
 
     if (root) {
       int next_node_index = 0;
@@ -835,7 +870,7 @@ void LightManager::device_update_tree(Device *,
     if (root) {
       /* Reserve enough size of all instance subtrees, then shrink back to
        * actual number of nodes used. */
-      light_link_nodes.resize(light_tree.num_nodes);
+      light_link_nodes.resize(light_tree->num_nodes);
       light_tree_emitters_copy_and_flatten(
           flatten, root, light_link_nodes.data(), kemitters, next_node_index);
       light_link_nodes.resize(next_node_index);
@@ -844,7 +879,7 @@ void LightManager::device_update_tree(Device *,
     /* Specialized light trees for linking. */
     for (uint64_t tree_index = 0; tree_index < LIGHT_LINK_SET_MAX; tree_index++) {
       const uint64_t tree_mask = uint64_t(1) << tree_index;
-      if (!(light_tree.light_link_receiver_used & tree_mask)) {
+      if (!(light_tree->light_link_receiver_used & tree_mask)) {
         continue;
       }
 
@@ -861,9 +896,11 @@ void LightManager::device_update_tree(Device *,
     memcpy(knodes, light_link_nodes.data(), light_link_nodes.size() * sizeof(*knodes));
 
     VLOG_INFO << "Specialized light tree for light linking, with "
-              << light_link_nodes.size() - light_tree.num_nodes << " additional nodes.";
+              << light_link_nodes.size() - light_tree->num_nodes << " additional nodes.";
   }
 
+  light_tree_flatten_restore_instances(flatten);
+
   /* Copy arrays to device. */
   dscene->light_tree_nodes.copy_to_device();
   dscene->light_tree_emitters.copy_to_device();
@@ -16,12 +16,14 @@
 #include "util/ies.h"
 #include "util/thread.h"
 #include "util/types.h"
+#include "util/unique_ptr.h"
 #include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
 class Device;
 class DeviceScene;
+class LightTree;
 class Progress;
 class Scene;
 class Shader;
@@ -102,6 +104,7 @@ class LightManager {
     OBJECT_MANAGER = (1 << 5),
     SHADER_COMPILED = (1 << 6),
     SHADER_MODIFIED = (1 << 7),
+    EMISSIVE_OBJECT_MODIFIED = (1 << 8),
 
     /* tag everything in the manager for an update */
     UPDATE_ALL = ~0u,
@@ -161,6 +164,10 @@ class LightManager {
   bool last_background_enabled;
   int last_background_resolution;
 
+  /* Light tree of the previous update, which is refit when only lights and emissive objects are
+   * modified without changing which of them are used. */
+  unique_ptr<LightTree> light_tree;
+
   uint32_t update_flags;
 };
 
@@ -249,14 +249,112 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, int prim_id)
   return false;
 }
 
-void LightTree::add_mesh(Scene *scene, Mesh *mesh, int object_id)
+void LightTree::add_mesh(Scene *scene,
+                         Mesh *mesh,
+                         int object_id,
+                         vector<LightTreeEmitter> &emitters)
 {
-  size_t mesh_num_triangles = mesh->num_triangles();
-  for (size_t i = 0; i < mesh_num_triangles; i++) {
-    if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+  /* Triangles of large meshes are processed in chunks in parallel, and the chunks are
+   * concatenated in order afterwards. */
+  const size_t mesh_num_triangles = mesh->num_triangles();
+  const size_t chunk_size = MIN_EMITTERS_PER_THREAD;
+  const size_t num_chunks = divide_up(mesh_num_triangles, chunk_size);
+
+  vector<vector<LightTreeEmitter>> chunk_emitters(num_chunks);
+  parallel_for(size_t(0), num_chunks, [&](const size_t chunk) {
+    const size_t chunk_start = chunk * chunk_size;
+    const size_t chunk_end = std::min(chunk_start + chunk_size, mesh_num_triangles);
+    for (size_t i = chunk_start; i < chunk_end; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        chunk_emitters[chunk].emplace_back(scene, i, object_id);
+      }
+    }
+  });
+
+  for (vector<LightTreeEmitter> &chunk : chunk_emitters) {
+    std::move(chunk.begin(), chunk.end(), std::back_inserter(emitters));
+  }
+}
+
+void LightTree::update_mesh_light_measure(Scene *scene,
+                                          LightTreeEmitter &emitter,
+                                          const LightTreeMeasure &subtree_measure)
+{
+  Object *object = scene->objects[emitter.object_id];
+  Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+
+  emitter.centroid = object->bounds.center();
+  emitter.measure = subtree_measure;
+
+  /* Transform measure. The measure is only directly transformable if the transformation has
+   * uniform scaling, otherwise recount all the triangles in the mesh with transformation. */
+  /* NOTE: in theory only energy needs recalculating: #bbox is available via `object->bounds`,
+   * transformation of #bcone is possible. However, the computation involves eigendecomposition
+   * and solving a cubic equation (https://doi.org/10.1016/j.nima.2009.11.075 section 3.4), then
+   * the angle is derived from the major axis of the resulted right elliptic cone's base, which
+   * can be an overestimation. */
+  if (!mesh->transform_applied && !emitter.measure.transform(object->get_tfm())) {
+    emitter.measure.reset();
+    size_t mesh_num_triangles = mesh->num_triangles();
+    for (size_t i = 0; i < mesh_num_triangles; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        emitter.measure.add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
+      }
+    }
+  }
+}
+
+void LightTree::update_object_lookup_offset(Scene *scene,
+                                            DeviceScene *dscene,
+                                            const LightTreeEmitter *emitters,
+                                            const int num_emitters)
+{
+  uint *object_offsets = dscene->object_lookup_offset.alloc(scene->objects.size());
+
+  for (int i = 0; i < num_emitters; i++) {
+    const LightTreeEmitter &emitter = emitters[i];
+    if (!emitter.is_mesh()) {
+      continue;
+    }
+    Object *object = scene->objects[emitter.object_id];
+    Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
+    object_offsets[emitter.object_id] = offset_map_[mesh];
+  }
+}
+
+vector<uint64_t> LightTree::get_topology(Scene *scene)
+{
+  vector<uint64_t> topology;
+
+  int scene_light_index = 0;
+  for (Light *light : scene->lights) {
+    if (light->is_enabled) {
+      const bool is_distant = light->light_type == LIGHT_BACKGROUND ||
+                              light->light_type == LIGHT_DISTANT;
+      topology.push_back(scene_light_index);
+      topology.push_back(is_distant);
+      topology.push_back(light->get_light_set_membership());
     }
+    scene_light_index++;
   }
+
+  int object_id = 0;
+  for (Object *object : scene->objects) {
+    topology.push_back(object->get_receiver_light_set());
+
+    if (object->usable_as_light()) {
+      /* Triangles of meshes with applied transform are stored in world space, so any change to
+       * the object changes the subtree of the mesh. Mark those with an invalid object index, so
+       * that the tree is never refit. */
+      const Mesh *mesh = static_cast<const Mesh *>(object->get_geometry());
+      topology.push_back(mesh->transform_applied ? ~uint64_t(0) : uint64_t(object_id));
+      topology.push_back(uint64_t(mesh));
+      topology.push_back(object->get_light_set_membership());
+    }
+    object_id++;
+  }
+
+  return topology;
 }
 
 LightTree::LightTree(Scene *scene,
@@ -267,6 +365,8 @@ LightTree::LightTree(Scene *scene,
 {
   KernelIntegrator *kintegrator = &dscene->data.integrator;
 
+  topology_ = get_topology(scene);
+
   local_lights_.reserve(kintegrator->num_lights - kintegrator->num_distant_lights);
   distant_lights_.reserve(kintegrator->num_distant_lights);
 
@@ -328,8 +428,8 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   const int num_distant_lights = distant_lights_.size();
 
   /* Create a node for each mesh light, and keep track of unique mesh lights. */
-  std::unordered_map<Mesh *, std::tuple<LightTreeNode *, int, int>> unique_mesh;
-  uint *object_offsets = dscene->object_lookup_offset.alloc(scene->objects.size());
+  std::unordered_map<Mesh *, LightTreeNode *> unique_mesh;
+  vector<const LightTreeEmitter *> unique_mesh_lights;
   emitters_.reserve(num_triangles + num_local_lights + num_distant_lights);
   for (LightTreeEmitter &emitter : mesh_lights_) {
     Object *object = scene->objects[emitter.object_id];
@@ -338,53 +438,56 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
 
     auto map_it = unique_mesh.find(mesh);
     if (map_it == unique_mesh.end()) {
-      const int start = emitters_.size();
-      add_mesh(scene, mesh, emitter.object_id);
-      const int end = emitters_.size();
-
-      unique_mesh[mesh] = std::make_tuple(emitter.root.get(), start, end);
+      unique_mesh[mesh] = emitter.root.get();
+      unique_mesh_lights.push_back(&emitter);
       emitter.root->object_id = emitter.object_id;
     }
     else {
-      emitter.root->make_instance(std::get<0>(map_it->second), emitter.object_id);
+      emitter.root->make_instance(map_it->second, emitter.object_id);
     }
-    object_offsets[emitter.object_id] = offset_map_[mesh];
+  }
+  update_object_lookup_offset(scene, dscene, mesh_lights_.data(), mesh_lights_.size());
+
+  /* Collect the emissive triangles of all unique meshes in parallel. They are appended in order
+   * of the mesh lights, so that the tree does not depend on the scheduling of the tasks. */
+  const int num_unique_meshes = unique_mesh_lights.size();
+  vector<vector<LightTreeEmitter>> mesh_emitters(num_unique_meshes);
+  parallel_for(0, num_unique_meshes, [&](const int i) {
+    const LightTreeEmitter *emitter = unique_mesh_lights[i];
+    Mesh *mesh = static_cast<Mesh *>(scene->objects[emitter->object_id]->get_geometry());
+    add_mesh(scene, mesh, emitter->object_id, mesh_emitters[i]);
+  });
+
+  vector<int2> mesh_emitter_ranges(num_unique_meshes);
+  for (int i = 0; i < num_unique_meshes; i++) {
+    const int start = emitters_.size();
+    std::move(mesh_emitters[i].begin(), mesh_emitters[i].end(), std::back_inserter(emitters_));
+    mesh_emitter_ranges[i] = make_int2(start, emitters_.size());
+  }
+  mesh_emitters.clear();
+
+  if (progress_.get_cancel()) {
+    return nullptr;
   }
 
   /* Build a subtree for each unique mesh light. */
-  parallel_for_each(unique_mesh, [this](auto &map_it) {
-    LightTreeNode *node = std::get<0>(map_it.second);
-    int start = std::get<1>(map_it.second);
-    int end = std::get<2>(map_it.second);
-    recursive_build(self, node, start, end, emitters_.data(), 0, 0);
-    node->type |= LIGHT_TREE_INSTANCE;
+  parallel_for(0, num_unique_meshes, [&](const int i) {
+    LightTreeNode *node = unique_mesh_lights[i]->root.get();
+    const int2 range = mesh_emitter_ranges[i];
+    recursive_build(self, node, range.x, range.y, emitters_.data(), 0, 0);
   });
   task_pool.wait_work();
 
+  for (const LightTreeEmitter *emitter : unique_mesh_lights) {
+    LightTreeNode *node = emitter->root.get();
+    node->type |= LIGHT_TREE_INSTANCE;
+    mesh_subtree_measures_[node] = node->measure;
+  }
+
   /* Update measure. */
   parallel_for_each(mesh_lights_, [&](LightTreeEmitter &emitter) {
-    Object *object = scene->objects[emitter.object_id];
-    Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
-
-    LightTreeNode *reference = std::get<0>(unique_mesh.find(mesh)->second);
-    emitter.measure = emitter.root->measure = reference->measure;
-
-    /* Transform measure. The measure is only directly transformable if the transformation has
-     * uniform scaling, otherwise recount all the triangles in the mesh with transformation. */
-    /* NOTE: in theory only energy needs recalculating: #bbox is available via `object->bounds`,
-     * transformation of #bcone is possible. However, the computation involves eigendecomposition
-     * and solving a cubic equation (https://doi.org/10.1016/j.nima.2009.11.075 section 3.4), then
-     * the angle is derived from the major axis of the resulted right elliptic cone's base, which
-     * can be an overestimation. */
-    if (!mesh->transform_applied && !emitter.measure.transform(object->get_tfm())) {
-      emitter.measure.reset();
-      size_t mesh_num_triangles = mesh->num_triangles();
-      for (size_t i = 0; i < mesh_num_triangles; i++) {
-        if (triangle_usable_as_light(mesh, i)) {
-          emitter.measure.add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
-        }
-      }
-    }
+    update_mesh_light_measure(
+        scene, emitter, mesh_subtree_measures_.at(emitter.root->get_reference()));
   });
 
   for (LightTreeEmitter &emitter : mesh_lights_) {
@@ -395,6 +498,11 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   const int num_emissive_triangles = emitters_.size();
   num_local_lights += num_emissive_triangles;
 
+  num_emissive_triangles_ = num_emissive_triangles;
+  num_local_lights_ = local_lights_.size();
+  num_mesh_lights_ = num_mesh_lights;
+  num_distant_lights_ = num_distant_lights;
+
   /* Build the top level tree. */
   root_ = create_node(LightTreeMeasure::empty, 0);
 
@@ -429,6 +537,81 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
   return root_.get();
 }
 
+bool LightTree::can_refit(Scene *scene) const
+{
+  return root_ != nullptr && get_topology(scene) == topology_;
+}
+
+LightTreeNode *LightTree::refit(Scene *scene, DeviceScene *dscene)
+{
+  assert(can_refit(scene));
+
+  /* Local lights and mesh lights are partitioned together while building, so they are mixed in
+   * the range following the emissive triangles. Distant lights are in a separate leaf. */
+  LightTreeEmitter *local_emitters = emitters_.data() + num_emissive_triangles_;
+  const int num_local_emitters = num_local_lights_ + num_mesh_lights_;
+  LightTreeEmitter *distant_lights = local_emitters + num_local_emitters;
+
+  update_object_lookup_offset(scene, dscene, local_emitters, num_local_emitters);
+
+  /* Lights are cheap to evaluate, recreate them to pick up all changes. */
+  auto update_light = [scene](LightTreeEmitter &emitter) {
+    LightTreeEmitter updated_emitter(scene, emitter.light_id, emitter.object_id);
+    emitter.centroid = updated_emitter.centroid;
+    emitter.measure = updated_emitter.measure;
+  };
+
+  parallel_for(0, num_local_emitters, [&](const int i) {
+    LightTreeEmitter &emitter = local_emitters[i];
+    if (emitter.is_mesh()) {
+      /* Mesh subtrees are in object space and do not change, only their instances are
+       * transformed. */
+      update_mesh_light_measure(
+          scene, emitter, mesh_subtree_measures_.at(emitter.root->get_reference()));
+      emitter.root->measure = emitter.measure;
+    }
+    else {
+      assert(emitter.is_light());
+      update_light(emitter);
+    }
+  });
+  parallel_for(0, num_distant_lights_, [&](const int i) { update_light(distant_lights[i]); });
+
+  refit_node(root_.get());
+
+  return root_.get();
+}
+
+void LightTree::refit_node(LightTreeNode *node)
+{
+  /* Subtrees for light linking are shared by index into the kernel nodes, which are recreated. */
+  node->light_link.shared_node_index = -1;
+
+  if (node->is_leaf() || node->is_distant()) {
+    const LightTreeNode::Leaf &leaf = node->get_leaf();
+    const LightTreeEmitter *emitters = emitters_.data() + leaf.first_emitter_index;
+
+    /* Match the measure computed while building, which is not accumulated for a single emitter. */
+    if (leaf.num_emitters == 1 && node->is_leaf()) {
+      node->measure = emitters[0].measure;
+    }
+    else {
+      node->measure.reset();
+      for (int i = 0; i < leaf.num_emitters; i++) {
+        node->measure.add(emitters[i].measure);
+      }
+    }
+    return;
+  }
+
+  assert(node->is_inner());
+  LightTreeNode *left_node = node->get_inner().children[left].get();
+  LightTreeNode *right_node = node->get_inner().children[right].get();
+  refit_node(left_node);
+  refit_node(right_node);
+  node->measure = left_node->measure + right_node->measure;
+}
+
 void LightTree::recursive_build(const Child child,
                                 LightTreeNode *inner,
                                 const int start,
@@ -511,13 +694,69 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
 
   middle = (start + end) / 2;
 
+  /* Large ranges of emitters are processed in chunks in parallel. The results of the chunks are
+   * merged in order, so that the tree does not depend on the scheduling of the tasks. */
+  const int chunk_size = MIN_EMITTERS_PER_THREAD;
+  const int num_chunks = divide_up(num_emitters, chunk_size);
+  auto for_each_chunk = [&](const auto &func) {
+    if (num_chunks == 1) {
+      func(0, start, end);
+      return;
+    }
+    parallel_for(0, num_chunks, [&](const int chunk) {
+      const int chunk_start = start + chunk * chunk_size;
+      func(chunk, chunk_start, min(chunk_start + chunk_size, end));
+    });
+  };
+
+  vector<BoundBox> chunk_centroid_bbox(num_chunks, BoundBox::empty);
+  for_each_chunk([&](const int chunk, const int chunk_start, const int chunk_end) {
+    for (int i = chunk_start; i < chunk_end; i++) {
+      chunk_centroid_bbox[chunk].grow(emitters[i].centroid);
+    }
+  });
+
   BoundBox centroid_bbox = BoundBox::empty;
-  for (int i = start; i < end; i++) {
-    centroid_bbox.grow((emitters + i)->centroid);
+  for (const BoundBox &bbox : chunk_centroid_bbox) {
+    centroid_bbox.grow(bbox);
   }
 
   const float3 extent = centroid_bbox.size();
   const float max_extent = max4(extent.x, extent.y, extent.z, 0.0f);
+  const float3 inv_extent = one_float3() / extent;
+
+  /* Fill in buckets with emitters for all dimensions at once, where the centroid box is split
+   * into equal partitions. Dimensions along which the centroid bounding box is 0 are skipped,
+   * except for the first one which is used to compute the node measure. */
+  typedef std::array<LightTreeBucket, LightTreeBucket::num_buckets> Buckets;
+  typedef std::array<Buckets, 3> DimBuckets;
+  vector<DimBuckets> chunk_buckets(num_chunks);
+  for_each_chunk([&](const int chunk, const int chunk_start, const int chunk_end) {
+    DimBuckets &buckets = chunk_buckets[chunk];
+    for (int i = chunk_start; i < chunk_end; i++) {
+      const LightTreeEmitter &emitter = emitters[i];
+      for (int dim = 0; dim < 3; dim++) {
+        int bucket_idx = 0;
+        if (extent[dim] != 0.0f) {
+          bucket_idx = LightTreeBucket::num_buckets *
+                       (emitter.centroid[dim] - centroid_bbox.min[dim]) * inv_extent[dim];
+          bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+        }
+        else if (dim != 0) {
+          continue;
+        }
+        buckets[dim][bucket_idx].add(emitter);
+      }
+    }
+  });
+
+  for (int chunk = 1; chunk < num_chunks; chunk++) {
+    for (int dim = 0; dim < 3; dim++) {
+      for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+        chunk_buckets[0][dim][i] = chunk_buckets[0][dim][i] + chunk_buckets[chunk][dim][i];
+      }
+    }
+  }
 
   /* Check each dimension to find the minimum splitting cost. */
   float total_cost = 0.0f;
@@ -529,21 +768,7 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
       continue;
     }
 
-    const float inv_extent = 1 / (centroid_bbox.size()[dim]);
-
-    /* Fill in buckets with emitters. */
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
-
-      buckets[bucket_idx].add(*emitter);
-    }
+    const Buckets &buckets = chunk_buckets[0][dim];
 
     /* Precompute the left bucket measure cumulatively. */
     std::array<LightTreeBucket, LightTreeBucket::num_buckets - 1> left_buckets;
@@ -581,7 +806,7 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
     }
 
     /* Calculate the cost of splitting at each point between partitions. */
-    const float regularization = max_extent * inv_extent;
+    const float regularization = max_extent * inv_extent[dim];
     for (int split = 0; split < LightTreeBucket::num_buckets - 1; split++) {
       const float left_cost = left_buckets[split].measure.calculate();
       const float right_cost = right_buckets[split].measure.calculate();
@@ -386,6 +386,20 @@ class LightTree {
 
   std::unordered_map<Mesh *, int> offset_map_;
 
+  /* Measure of the subtree of every unique mesh, in object space. The root node of the subtree
+   * holds the measure transformed by the object which owns it. */
+  std::unordered_map<const LightTreeNode *, LightTreeMeasure> mesh_subtree_measures_;
+
+  /* Layout of the emitters after the build: emissive triangles, followed by local lights and mesh
+   * lights in the order of the tree, and distant lights. */
+  int num_emissive_triangles_ = 0;
+  int num_local_lights_ = 0;
+  int num_mesh_lights_ = 0;
+  int num_distant_lights_ = 0;
+
+  /* Lights and objects the tree was built for, see `get_topology()`. */
+  vector<uint64_t> topology_;
+
   Progress &progress_;
 
   uint max_lights_in_leaf_;
@@ -409,6 +423,15 @@ class LightTree {
   /* Returns a pointer to the root node. */
   LightTreeNode *build(Scene *scene, DeviceScene *dscene);
 
+  /* Check whether the tree was built for the same lights and emissive objects, so that it can be
+   * updated with `refit()` instead of being built again. */
+  bool can_refit(Scene *scene) const;
+
+  /* Update the measures of the lights and the mesh light instances, for changed strength or
+   * transform, keeping the structure of the tree. The subtrees of the meshes are kept as-is.
+   * Returns a pointer to the root node. */
+  LightTreeNode *refit(Scene *scene, DeviceScene *dscene);
+
   /* NOTE: Always use this function to create a new node so the number of nodes is in sync. */
   unique_ptr<LightTreeNode> create_node(const LightTreeMeasure &measure, const uint &bit_trial)
   {
@@ -440,6 +463,9 @@ class LightTree {
                        uint bit_trail,
                        int depth);
 
+  /* Refit the measure of the node from its children or emitters. */
+  void refit_node(LightTreeNode *node);
+
   bool should_split(LightTreeEmitter *emitters,
                     const int start,
                     int &middle,
@@ -451,8 +477,24 @@ class LightTree {
   /* Check whether the light tree can use this triangle as light-emissive. */
   bool triangle_usable_as_light(Mesh *mesh, int prim_id);
 
-  /* Add all the emissive triangles of a mesh to the light tree. */
-  void add_mesh(Scene *scene, Mesh *mesh, int object_id);
+  /* Collect all the emissive triangles of a mesh, in order of their index. */
+  void add_mesh(Scene *scene, Mesh *mesh, int object_id, vector<LightTreeEmitter> &emitters);
+
+  /* Compute the world space measure of a mesh light from the measure of its subtree. */
+  void update_mesh_light_measure(Scene *scene,
+                                 LightTreeEmitter &emitter,
+                                 const LightTreeMeasure &subtree_measure);
+
+  /* Fill in the offsets of the triangles of mesh lights into the triangle lookup array. Emitters
+   * which are not mesh lights are skipped. */
+  void update_object_lookup_offset(Scene *scene,
+                                   DeviceScene *dscene,
+                                   const LightTreeEmitter *emitters,
+                                   const int num_emitters);
+
+  /* Enabled lights and emissive objects with their properties which affect the structure of the
+   * tree. */
+  static vector<uint64_t> get_topology(Scene *scene);
 };
 
 CCL_NAMESPACE_END
@@ -15,6 +15,7 @@
 #include "util/map.h"
 #include "util/progress.h"
 #include "util/set.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -33,14 +34,14 @@ static float3 compute_face_normal(const Mesh::Triangle &t, float3 *verts)
   return norm / normlen;
 }
 
-/* Fill in coordinates for mesh displacement shader evaluation on device. */
+/* Fill in coordinates for mesh displacement shader evaluation on device. Returns the number of
+ * inputs written. */
 static int fill_shader_input(const Scene *scene,
                              const Mesh *mesh,
                              const size_t object_index,
-                             device_vector<KernelShaderEvalInput> &d_input)
+                             KernelShaderEvalInput *d_input_data)
 {
   int d_input_size = 0;
-  KernelShaderEvalInput *d_input_data = d_input.data();
 
   const array<int> &mesh_shaders = mesh->get_shader();
   const array<Node *> &mesh_used_shaders = mesh->get_used_shaders();
@@ -100,10 +101,8 @@ static int fill_shader_input(const Scene *scene,
   return d_input_size;
 }
 
-/* Read back mesh displacement shader output. */
-static void read_shader_output(const Scene *scene,
-                               Mesh *mesh,
-                               const device_vector<float> &d_output)
+/* Read back mesh displacement shader output. Returns the number of floats read. */
+static int read_shader_output(const Scene *scene, Mesh *mesh, const float *d_output_data)
 {
   const array<int> &mesh_shaders = mesh->get_shader();
   const array<Node *> &mesh_used_shaders = mesh->get_used_shaders();
@@ -113,7 +112,6 @@ static void read_shader_output(const Scene *scene,
   const int num_motion_steps = mesh->get_motion_steps();
   vector<bool> done(num_verts, false);
 
-  const float *d_output_data = d_output.data();
   int d_output_index = 0;
 
   Attribute *attr_mP = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
@@ -149,46 +147,16 @@ static void read_shader_output(const Scene *scene,
       }
     }
   }
+
+  return d_output_index;
 }
 
-bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progress &progress)
+/* Stitch vertices and recompute normals after displacement was applied to the mesh. */
+static void displace_stitch_and_normals(const Scene *scene, Mesh *mesh)
 {
-  /* verify if we have a displacement shader */
-  if (!mesh->has_true_displacement()) {
-    return false;
-  }
-
   const size_t num_verts = mesh->verts.size();
   const size_t num_triangles = mesh->num_triangles();
 
-  if (num_triangles == 0) {
-    return false;
-  }
-
-  string msg = string_printf("Computing Displacement %s", mesh->name.c_str());
-  progress.set_status("Updating Mesh", msg);
-
-  /* find object index. todo: is arbitrary */
-  size_t object_index = OBJECT_NONE;
-
-  for (size_t i = 0; i < scene->objects.size(); i++) {
-    if (scene->objects[i]->get_geometry() == mesh) {
-      object_index = i;
-      break;
-    }
-  }
-
-  /* Evaluate shader on device. */
-  ShaderEval shader_eval(device, progress);
-  if (!shader_eval.eval(SHADER_EVAL_DISPLACE,
-                        num_verts,
-                        3,
-                        function_bind(&fill_shader_input, scene, mesh, object_index, _1),
-                        function_bind(&read_shader_output, scene, mesh, _1)))
-  {
-    return false;
-  }
-
   /* stitch */
   unordered_set<int> stitch_keys;
   for (pair<int, int> i : mesh->vert_to_stitching_key_map) {
@@ -392,6 +360,63 @@ bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progres
       }
     }
   }
+}
+
+bool GeometryManager::displace(Device *device,
+                               Scene *scene,
+                               const vector<Mesh *> &meshes,
+                               Progress &progress)
+{
+  string msg = (meshes.size() == 1) ?
+                   string_printf("Computing Displacement %s", meshes[0]->name.c_str()) :
+                   string_printf("Computing Displacement of %u meshes", (uint)meshes.size());
+  progress.set_status("Updating Mesh", msg);
+
+  /* find object index. todo: is arbitrary */
+  unordered_map<const Geometry *, size_t> geometry_object_index;
+  for (size_t i = 0; i < scene->objects.size(); i++) {
+    geometry_object_index.emplace(scene->objects[i]->get_geometry(), i);
+  }
+
+  vector<size_t> object_indices(meshes.size(), OBJECT_NONE);
+  size_t max_num_inputs = 0;
+
+  for (size_t i = 0; i < meshes.size(); i++) {
+    auto it = geometry_object_index.find(meshes[i]);
+    if (it != geometry_object_index.end()) {
+      object_indices[i] = it->second;
+    }
+    max_num_inputs += meshes[i]->verts.size();
+  }
+
+  /* Evaluate shader on device for all meshes at once, so the cost of launching the kernel and
+   * copying data is paid once rather than for every mesh. */
+  ShaderEval shader_eval(device, progress);
+  if (!shader_eval.eval(
+          SHADER_EVAL_DISPLACE,
+          max_num_inputs,
+          3,
+          [&](device_vector<KernelShaderEvalInput> &d_input) {
+            int d_input_size = 0;
+            for (size_t i = 0; i < meshes.size(); i++) {
+              d_input_size += fill_shader_input(
+                  scene, meshes[i], object_indices[i], d_input.data() + d_input_size);
+            }
+            return d_input_size;
+          },
+          [&](device_vector<float> &d_output) {
+            const float *d_output_data = d_output.data();
+            foreach (Mesh *mesh, meshes) {
+              d_output_data += read_shader_output(scene, mesh, d_output_data);
+            }
+          }))
+  {
+    return false;
+  }
+
+  parallel_for(size_t(0), meshes.size(), [&](size_t i) {
+    displace_stitch_and_normals(scene, meshes[i]);
+  });
 
   return true;
 }
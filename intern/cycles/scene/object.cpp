@@ -236,7 +236,7 @@ void Object::tag_update(Scene *scene)
     foreach (Node *node, geometry->get_used_shaders()) {
       Shader *shader = static_cast<Shader *>(node);
       if (shader->emission_sampling != EMISSION_SAMPLING_NONE)
-        scene->light_manager->tag_update(scene, LightManager::EMISSIVE_MESH_MODIFIED);
+        scene->light_manager->tag_update(scene, LightManager::EMISSIVE_OBJECT_MODIFIED);
     }
   }
 
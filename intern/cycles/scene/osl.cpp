@@ -45,6 +45,11 @@ int OSLShaderManager::ss_shared_users = 0;
 thread_mutex OSLShaderManager::ss_shared_mutex;
 thread_mutex OSLShaderManager::ss_mutex;
 
+/* Optimized shader groups, shared between renders in the same process. */
+map<string, OSLShaderManager::ShaderGroupCacheEntry> OSLShaderManager::group_cache;
+uint64_t OSLShaderManager::group_cache_clock = 0;
+bool OSLShaderManager::ss_shared_retained = false;
+
 int OSLCompiler::texture_shared_unique_id = 0;
 
 /* Shader Manager */
@@ -63,6 +68,24 @@ OSLShaderManager::~OSLShaderManager()
 
 void OSLShaderManager::free_memory()
 {
+  {
+    /* Free shading systems kept alive for the shader group cache. */
+    thread_scoped_lock ss_lock(ss_mutex);
+    thread_scoped_lock lock(ss_shared_mutex);
+
+    group_cache.clear();
+
+    if (ss_shared_retained) {
+      ss_shared_retained = false;
+
+      if (ss_shared_users == 0) {
+        shading_system_destroy();
+      }
+
+      texture_system_free();
+    }
+  }
+
 #  ifdef OSL_HAS_BLENDER_CLEANUP_FIX
   /* There is a problem with LLVM+OSL: The order global destructors across
    * different compilation units run cannot be guaranteed, on windows this means
@@ -117,6 +140,9 @@ void OSLShaderManager::device_update_specific(Device *device,
   /* create shaders */
   Shader *background_shader = scene->background->get_shader(scene);
 
+  group_cache_hits = 0;
+  group_cache_misses = 0;
+
   foreach (Shader *shader, scene->shaders) {
     assert(shader->graph);
 
@@ -142,6 +168,14 @@ void OSLShaderManager::device_update_specific(Device *device,
       scene->light_manager->tag_update(scene, LightManager::SHADER_COMPILED);
   }
 
+  size_t group_cache_size;
+  {
+    thread_scoped_lock lock(ss_mutex);
+    group_cache_size = group_cache.size();
+  }
+  VLOG_INFO << "OSL shader group cache: " << group_cache_hits << " hits, " << group_cache_misses
+            << " misses, " << group_cache_size << " groups cached.";
+
   /* setup shader engine */
   int background_id = scene->shader_manager->get_shader_id(background_shader);
 
@@ -279,7 +313,9 @@ void OSLShaderManager::shading_system_init()
   device_->foreach_device([](Device *sub_device) {
     const DeviceType device_type = sub_device->info.type;
 
-    if (ss_shared_users++ == 0 || ss_shared.find(device_type) == ss_shared.end()) {
+    ss_shared_users++;
+
+    if (ss_shared.find(device_type) == ss_shared.end()) {
       /* Must use aligned new due to concurrent hash map. */
       OSLRenderServices *services = util_aligned_new<OSLRenderServices>(ts_shared, device_type);
 
@@ -360,23 +396,84 @@ void OSLShaderManager::shading_system_init()
 void OSLShaderManager::shading_system_free()
 {
   /* shared shading system decrease users and destroy if no longer used */
+  thread_scoped_lock ss_lock(ss_mutex);
   thread_scoped_lock lock(ss_shared_mutex);
 
   device_->foreach_device([](Device * /*sub_device*/) {
     if (--ss_shared_users == 0) {
-      for (const auto &[device_type, ss] : ss_shared) {
-        OSLRenderServices *services = static_cast<OSLRenderServices *>(ss->renderer());
-
-        delete ss;
+      if (!group_cache.empty()) {
+        /* Keep the shading systems and their texture system alive so the next render in this
+         * process can reuse optimized shader groups, until free_memory() is called. */
+        thread_scoped_lock ts_lock(ts_shared_mutex);
+
+        if (!ss_shared_retained) {
+          ss_shared_retained = true;
+          ts_shared_users++;
+        }
 
-        util_aligned_delete(services);
+        /* No render uses the texture system now, release its cached tiles and file handles so
+         * that only the shader groups stay in memory between renders. */
+        ts_shared->invalidate_all(true);
+        return;
       }
 
-      ss_shared.clear();
+      shading_system_destroy();
     }
   });
 }
 
+void OSLShaderManager::shading_system_destroy()
+{
+  for (const auto &[device_type, ss] : ss_shared) {
+    OSLRenderServices *services = static_cast<OSLRenderServices *>(ss->renderer());
+
+    delete ss;
+
+    util_aligned_delete(services);
+  }
+
+  ss_shared.clear();
+}
+
+OSL::ShaderGroupRef OSLShaderManager::shader_group_cached(OSL::ShadingSystem *ss,
+                                                          OSL::ShaderGroupRef group)
+{
+  /* The serialized group fully describes the shaders, parameters and connections, so identical
+   * groups optimize to identical code. Groups belong to the shading system that created them. */
+  ustring pickle;
+  if (!ss->getattribute(group.get(), "pickle", TypeDesc::STRING, &pickle)) {
+    return group;
+  }
+
+  MD5Hash md5;
+  md5.append((const uint8_t *)pickle.c_str(), pickle.size());
+  const string key = string_printf("%p_%d_", (void *)ss, OSL_LIBRARY_VERSION_CODE) +
+                     md5.get_hex();
+
+  auto it = group_cache.find(key);
+  if (it != group_cache.end()) {
+    it->second.last_used = ++group_cache_clock;
+    group_cache_hits++;
+    return it->second.group;
+  }
+
+  group_cache_misses++;
+
+  if (group_cache.size() >= OSL_GROUP_CACHE_MAX_SIZE) {
+    /* Evict least recently used group, any shader still using it keeps its own reference. */
+    auto lru = group_cache.begin();
+    for (auto entry = group_cache.begin(); entry != group_cache.end(); ++entry) {
+      if (entry->second.last_used < lru->second.last_used) {
+        lru = entry;
+      }
+    }
+    group_cache.erase(lru);
+  }
+
+  group_cache[key] = {group, ++group_cache_clock};
+  return group;
+}
+
 bool OSLShaderManager::osl_compile(const string &inputfile, const string &outputfile)
 {
   vector<string> options;
@@ -698,6 +795,7 @@ OSLCompiler::OSLCompiler(OSLShaderManager *manager, OSL::ShadingSystem *ss, Scen
   current_type = SHADER_TYPE_SURFACE;
   current_shader = NULL;
   background = false;
+  group_cacheable = true;
 }
 
 string OSLCompiler::id(ShaderNode *node)
@@ -1213,6 +1311,7 @@ OSL::ShaderGroupRef OSLCompiler::compile_type(Shader *shader, ShaderGraph *graph
   name << "shader_" << shader->name.hash();
 
   OSL::ShaderGroupRef group = ss->ShaderGroupBegin(name.str());
+  group_cacheable = true;
 
   ShaderNode *output = graph->output();
   ShaderNodeSet dependencies;
@@ -1246,6 +1345,11 @@ OSL::ShaderGroupRef OSLCompiler::compile_type(Shader *shader, ShaderGraph *graph
 
   ss->ShaderGroupEnd();
 
+  /* Reuse an identical group optimized by an earlier render. */
+  if (group_cacheable) {
+    return manager->shader_group_cached(ss, group);
+  }
+
   return group;
 }
 
@@ -1342,6 +1446,9 @@ void OSLCompiler::parameter_texture(const char *name, const ImageHandle &handle)
   services->textures.insert(filename,
                             new OSLTextureHandle(OSLTextureHandle::SVM, handle.get_svm_slots()));
   parameter(name, filename);
+
+  /* Texture handles of the image manager don't outlive this render. */
+  group_cacheable = false;
 }
 
 void OSLCompiler::parameter_texture_ies(const char *name, int svm_slot)
@@ -1350,6 +1457,7 @@ void OSLCompiler::parameter_texture_ies(const char *name, int svm_slot)
   ustring filename(string_printf("@svm%d", texture_shared_unique_id++).c_str());
   services->textures.insert(filename, new OSLTextureHandle(OSLTextureHandle::IES, svm_slot));
   parameter(name, filename);
+  group_cacheable = false;
 }
 
 #else
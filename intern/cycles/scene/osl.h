@@ -96,12 +96,27 @@ class OSLShaderManager : public ShaderManager {
   /* Get image slots used by OSL services on device. */
   static void osl_image_slots(Device *device, ImageManager *image_manager, set<int> &image_slots);
 
+  /* Return an identical shader group from earlier renders if any, so it does not have to be
+   * optimized and JIT compiled again. Otherwise the group is added to the cache. */
+  OSL::ShaderGroupRef shader_group_cached(OSL::ShadingSystem *ss, OSL::ShaderGroupRef group);
+
+  /* Number of shader groups found in and added to the cache by the last shader update. */
+  int get_group_cache_hits() const
+  {
+    return group_cache_hits;
+  }
+  int get_group_cache_misses() const
+  {
+    return group_cache_misses;
+  }
+
  private:
   void texture_system_init();
-  void texture_system_free();
+  static void texture_system_free();
 
   void shading_system_init();
   void shading_system_free();
+  static void shading_system_destroy();
 
   Device *device_;
   map<string, OSLShaderInfo> loaded_shaders;
@@ -115,6 +130,19 @@ class OSLShaderManager : public ShaderManager {
   static thread_mutex ss_shared_mutex;
   static thread_mutex ss_mutex;
   static int ss_shared_users;
+
+  struct ShaderGroupCacheEntry {
+    OSL::ShaderGroupRef group;
+    uint64_t last_used;
+  };
+
+  static const size_t OSL_GROUP_CACHE_MAX_SIZE = 1024;
+  static map<string, ShaderGroupCacheEntry> group_cache;
+  static uint64_t group_cache_clock;
+  static bool ss_shared_retained;
+
+  int group_cache_hits = 0;
+  int group_cache_misses = 0;
 };
 
 #endif
@@ -177,6 +205,7 @@ class OSLCompiler {
 
   ShaderType current_type;
   Shader *current_shader;
+  bool group_cacheable;
 
   static int texture_shared_unique_id;
 };
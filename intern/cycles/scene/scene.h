@@ -71,6 +71,8 @@ class SceneParams {
   int num_bvh_time_steps;
   int hair_subdivisions;
   CurveShapeType hair_shape;
+  /* Store curve keys on the device quantized to 16 bits per component, with BVH2 only. */
+  bool use_compact_curves;
   int texture_limit;
 
   bool background;
@@ -86,6 +88,7 @@ class SceneParams {
     num_bvh_time_steps = 0;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
+    use_compact_curves = false;
     texture_limit = 0;
     background = true;
   }
@@ -99,6 +102,7 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
+             use_compact_curves == params.use_compact_curves &&
              texture_limit == params.texture_limit);
   }
 
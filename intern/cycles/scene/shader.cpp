@@ -17,6 +17,7 @@
 #include "scene/shader.h"
 #include "scene/shader_graph.h"
 #include "scene/shader_nodes.h"
+#include "scene/stats.h"
 #include "scene/svm.h"
 #include "scene/tables.h"
 
@@ -106,6 +107,7 @@ Shader::Shader() : Node(get_node_type())
   has_integrator_dependency = false;
   has_volume_connected = false;
   prev_volume_step_rate = 0.0f;
+  num_svm_nodes = 0;
 
   emission_estimate = zero_float3();
   emission_sampling = EMISSION_SAMPLING_NONE;
@@ -762,6 +764,17 @@ float3 ShaderManager::rec709_to_scene_linear(float3 c)
   return make_float3(dot(rec709_to_r, c), dot(rec709_to_g, c), dot(rec709_to_b, c));
 }
 
+void ShaderManager::collect_statistics(Scene *scene, RenderStats *stats)
+{
+  foreach (Shader *shader, scene->shaders) {
+    if (shader->num_svm_nodes == 0) {
+      continue;
+    }
+    stats->svm.add_entry(
+        NamedSizeEntry(shader->name.string(), shader->num_svm_nodes * sizeof(int4)));
+  }
+}
+
 string ShaderManager::get_cryptomatte_materials(Scene *scene)
 {
   string manifest = "{";
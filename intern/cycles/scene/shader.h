@@ -28,6 +28,7 @@ class Device;
 class DeviceScene;
 class Mesh;
 class Progress;
+class RenderStats;
 class Scene;
 class ShaderGraph;
 struct float3;
@@ -115,6 +116,9 @@ class Shader : public Node {
   bool has_volume_attribute_dependency;
   bool has_integrator_dependency;
 
+  /* Number of SVM nodes the shader was compiled into, zero when not compiled to SVM. */
+  int num_svm_nodes;
+
   float3 emission_estimate;
   EmissionSampling emission_sampling;
   bool emission_is_constant;
@@ -218,6 +222,9 @@ class ShaderManager {
 
   string get_cryptomatte_materials(Scene *scene);
 
+  /* Size of the compiled SVM nodes of every shader. */
+  void collect_statistics(Scene *scene, RenderStats *stats);
+
   void tag_update(Scene *scene, uint32_t flag);
 
   bool need_update() const;
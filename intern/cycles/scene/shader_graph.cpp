@@ -589,6 +589,41 @@ void ShaderGraph::simplify_settings(Scene *scene)
   }
 }
 
+/* Merge mapping nodes with constant parameters into the texture mapping of the texture nodes they
+ * feed, so the texture node applies the precomputed matrix itself. The mapping node is removed
+ * once it has no other users. Only used for SVM. */
+void ShaderGraph::merge_texture_mapping_nodes()
+{
+  foreach (ShaderNode *node, nodes) {
+    TextureMapping *tex_mapping = node->get_texture_mapping();
+    if (tex_mapping == NULL || !tex_mapping->skip()) {
+      continue;
+    }
+
+    ShaderInput *vector_in = node->input("Vector");
+    if (vector_in == NULL || vector_in->link == NULL ||
+        vector_in->link->parent->type != MappingNode::get_node_type())
+    {
+      continue;
+    }
+
+    MappingNode *mapping_node = static_cast<MappingNode *>(vector_in->link->parent);
+    ShaderInput *mapping_vector_in = mapping_node->input("Vector");
+    if (mapping_vector_in->link == NULL) {
+      continue;
+    }
+
+    TextureMapping mapping = *tex_mapping;
+    if (!mapping_node->to_texture_mapping(&mapping)) {
+      continue;
+    }
+
+    *tex_mapping = mapping;
+    disconnect(vector_in);
+    connect(mapping_vector_in->link, vector_in);
+  }
+}
+
 /* Deduplicate nodes with same settings. */
 void ShaderGraph::deduplicate_nodes()
 {
@@ -772,6 +807,10 @@ void ShaderGraph::clean(Scene *scene)
   /* NOTE: Remove proxy nodes was already done. */
   constant_fold(scene);
   simplify_settings(scene);
+  /* OSL texture mapping only applies the matrix, without the normalization of the normal type. */
+  if (!scene->shader_manager->use_osl()) {
+    merge_texture_mapping_nodes();
+  }
   deduplicate_nodes();
   verify_volume_output();
 
@@ -31,6 +31,7 @@ class OSLCompiler;
 class OutputNode;
 class ConstantFolder;
 class MD5Hash;
+class TextureMapping;
 
 /* Bump
  *
@@ -208,6 +209,12 @@ class ShaderNode : public Node {
   {
     return false;
   }
+
+  /* Texture mapping applied to the "Vector" input, for texture nodes. */
+  virtual TextureMapping *get_texture_mapping()
+  {
+    return NULL;
+  }
   vector<ShaderInput *> inputs;
   vector<ShaderOutput *> outputs;
 
@@ -360,6 +367,7 @@ class ShaderGraph : public NodeOwner {
   void clean(Scene *scene);
   void constant_fold(Scene *scene);
   void simplify_settings(Scene *scene);
+  void merge_texture_mapping_nodes();
   void deduplicate_nodes();
   void verify_volume_output();
 };
@@ -367,12 +367,20 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
   const bool compress_as_srgb = metadata.compress_as_srgb;
   const ustring known_colorspace = metadata.colorspace;
 
-  int vector_offset = tex_mapping.compile_begin(compiler, vector_in);
+  /* Flat and projected lookups apply a plain texture mapping matrix as part of the image node. */
+  const bool inline_mapping = projection != NODE_IMAGE_PROJ_BOX && !tex_mapping.skip() &&
+                              !tex_mapping.use_minmax &&
+                              tex_mapping.type != TextureMapping::NORMAL;
+  int vector_offset = (inline_mapping) ? compiler.stack_assign(vector_in) :
+                                         tex_mapping.compile_begin(compiler, vector_in);
   uint flags = 0;
 
   if (compress_as_srgb) {
     flags |= NODE_IMAGE_COMPRESS_AS_SRGB;
   }
+  if (inline_mapping) {
+    flags |= NODE_IMAGE_TRANSFORM_VECTOR;
+  }
   if (!alpha_out->links.empty()) {
     const bool unassociate_alpha = !(ColorSpaceManager::colorspace_is_data(colorspace) ||
                                      alpha_type == IMAGE_ALPHA_CHANNEL_PACKED ||
@@ -401,6 +409,13 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
                                              flags),
                       projection);
 
+    if (inline_mapping) {
+      Transform tfm = tex_mapping.compute_transform();
+      compiler.add_node(tfm.x);
+      compiler.add_node(tfm.y);
+      compiler.add_node(tfm.z);
+    }
+
     if (num_nodes > 0) {
       for (int i = 0; i < num_nodes; i++) {
         int4 node;
@@ -429,7 +444,9 @@ void ImageTextureNode::compile(SVMCompiler &compiler)
                       __float_as_int(projection_blend));
   }
 
-  tex_mapping.compile_end(compiler, vector_in, vector_offset);
+  if (!inline_mapping) {
+    tex_mapping.compile_end(compiler, vector_in, vector_offset);
+  }
 }
 
 void ImageTextureNode::compile(OSLCompiler &compiler)
@@ -2018,6 +2035,51 @@ void MappingNode::constant_fold(const ConstantFolder &folder)
   }
 }
 
+bool MappingNode::to_texture_mapping(TextureMapping *tex_mapping)
+{
+  if (input("Location")->link || input("Rotation")->link || input("Scale")->link) {
+    return false;
+  }
+
+  /* Texture mapping keeps its matrix invertible by clamping the scale to 1e-5, while this node
+   * divides safely by zero, so only larger scales give the same result. */
+  const bool has_zero_scale = fabsf(scale.x) < 1e-5f || fabsf(scale.y) < 1e-5f ||
+                              fabsf(scale.z) < 1e-5f;
+
+  switch (mapping_type) {
+    case NODE_MAPPING_TYPE_POINT:
+      tex_mapping->type = TextureMapping::POINT;
+      break;
+    case NODE_MAPPING_TYPE_TEXTURE:
+      if (has_zero_scale) {
+        return false;
+      }
+      tex_mapping->type = TextureMapping::TEXTURE;
+      break;
+    case NODE_MAPPING_TYPE_VECTOR:
+      tex_mapping->type = TextureMapping::VECTOR;
+      break;
+    case NODE_MAPPING_TYPE_NORMAL:
+      if (has_zero_scale) {
+        return false;
+      }
+      tex_mapping->type = TextureMapping::NORMAL;
+      break;
+    default:
+      return false;
+  }
+
+  tex_mapping->translation = location;
+  tex_mapping->rotation = rotation;
+  tex_mapping->scale = scale;
+  tex_mapping->x_mapping = TextureMapping::X;
+  tex_mapping->y_mapping = TextureMapping::Y;
+  tex_mapping->z_mapping = TextureMapping::Z;
+  tex_mapping->use_minmax = false;
+
+  return true;
+}
+
 void MappingNode::compile(SVMCompiler &compiler)
 {
   ShaderInput *vector_in = input("Vector");
@@ -2026,6 +2088,15 @@ void MappingNode::compile(SVMCompiler &compiler)
   ShaderInput *scale_in = input("Scale");
   ShaderOutput *vector_out = output("Vector");
 
+  /* With constant parameters the transform is computed once here, instead of loading the
+   * parameters and building the rotation matrix for every evaluation. */
+  TextureMapping tex_mapping;
+  if (to_texture_mapping(&tex_mapping)) {
+    tex_mapping.compile(
+        compiler, compiler.stack_assign(vector_in), compiler.stack_assign(vector_out));
+    return;
+  }
+
   int vector_stack_offset = compiler.stack_assign(vector_in);
   int location_stack_offset = compiler.stack_assign(location_in);
   int rotation_stack_offset = compiler.stack_assign(rotation_in);
@@ -55,6 +55,11 @@ class TextureMapping {
 class TextureNode : public ShaderNode {
  public:
   explicit TextureNode(const NodeType *node_type) : ShaderNode(node_type) {}
+  TextureMapping *get_texture_mapping()
+  {
+    return &tex_mapping;
+  }
+
   TextureMapping tex_mapping;
   NODE_SOCKET_API_STRUCT_MEMBER(float3, tex_mapping, translation)
   NODE_SOCKET_API_STRUCT_MEMBER(float3, tex_mapping, rotation)
@@ -412,6 +417,10 @@ class MappingNode : public ShaderNode {
   SHADER_NODE_CLASS(MappingNode)
   void constant_fold(const ConstantFolder &folder);
 
+  /* Fill in texture mapping equivalent to this node, when the location, rotation and scale are
+   * constant. Returns false if the mapping depends on other nodes. */
+  bool to_texture_mapping(TextureMapping *tex_mapping);
+
   NODE_SOCKET_API(float3, vector)
   NODE_SOCKET_API(float3, location)
   NODE_SOCKET_API(float3, rotation)
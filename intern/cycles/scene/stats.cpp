@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: Apache-2.0 */
 
 #include "scene/stats.h"
+#include "kernel/svm/types.h"
+#include "scene/image.h"
 #include "scene/object.h"
 #include "util/algorithm.h"
 #include "util/foreach.h"
@@ -39,6 +41,45 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+/* Name of the SVM node type as used in the reports, without the common prefix. */
+const char *svm_node_type_name(int node)
+{
+  static const char *names[] = {
+#define SHADER_NODE_TYPE(name) #name,
+#include "kernel/svm/node_types_template.h"
+  };
+  static const int prefix_length = sizeof("NODE_") - 1;
+
+  return names[node] + prefix_length;
+}
+
+string json_string(const string &str)
+{
+  string result = "\"";
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          result += string_printf("\\u%04x", c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0) {}
@@ -79,6 +120,22 @@ string NamedSizeStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSizeStats::json_report()
+{
+  sort(entries.begin(), entries.end(), namedSizeEntryComparator);
+
+  string result = "[";
+  foreach (const NamedSizeEntry &entry, entries) {
+    if (result.size() > 1) {
+      result += ", ";
+    }
+    result += string_printf("{\"name\": %s, \"size\": %zu}",
+                            json_string(entry.name).c_str(),
+                            entry.size);
+  }
+  return result + "]";
+}
+
 string NamedTimeStats::full_report(int indent_level)
 {
   const string indent(indent_level * kIndentNumSpaces, ' ');
@@ -146,6 +203,31 @@ string NamedNestedSampleStats::full_report(int indent_level, uint64_t total_samp
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf("{\"name\": %s, \"total_seconds\": %.3f, \"self_seconds\": %.3f",
+                                json_string(name).c_str(),
+                                sum_samples * 0.001,
+                                self_samples * 0.001);
+
+  if (!entries.empty()) {
+    sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+
+    result += ", \"entries\": [";
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (i != 0) {
+        result += ", ";
+      }
+      result += entries[i].json_report();
+    }
+    result += "]";
+  }
+
+  return result + "}";
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits)
@@ -198,6 +280,29 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  foreach (entry_map::const_reference entry, entries) {
+    sorted_entries.push_back(entry.second);
+  }
+
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  string result = "[";
+  foreach (const NamedSampleCountPair &entry, sorted_entries) {
+    if (result.size() > 1) {
+      result += ", ";
+    }
+    result += string_printf("{\"name\": %s, \"seconds\": %.3f, \"hits\": %llu}",
+                            json_string(entry.name.string()).c_str(),
+                            entry.samples * 0.001,
+                            (unsigned long long)entry.hits);
+  }
+  return result + "]";
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats() {}
@@ -280,6 +385,32 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
       objects.add(object->name, samples, hits);
     }
   }
+
+  svm_nodes.entries.clear();
+  for (int node = 0; node < NODE_NUM; node++) {
+    uint64_t samples, hits;
+    if (prof.get_svm_node(node, samples, hits)) {
+      svm_nodes.add(ustring(svm_node_type_name(node)), samples, hits);
+    }
+  }
+
+  shader_svm_nodes = NamedNestedSampleStats("Shader nodes", 0);
+  foreach (Shader *shader, scene->shaders) {
+    NamedNestedSampleStats *shader_entry = nullptr;
+    for (int node = 0; node < NODE_NUM; node++) {
+      const uint64_t samples = prof.get_shader_svm_node(shader->id, node);
+      if (samples == 0) {
+        continue;
+      }
+      if (shader_entry == nullptr) {
+        shader_entry = &shader_svm_nodes.add_entry(shader->name.string(), 0);
+      }
+      shader_entry->add_entry(svm_node_type_name(node), samples);
+    }
+  }
+
+  image_fetches = NamedSizeStats();
+  scene->image_manager->collect_profiling(this, prof);
 }
 
 string RenderStats::full_report()
@@ -287,10 +418,14 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += "Shader compilation statistics:\n" + svm.full_report(1);
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
+    result += "Shader node statistics:\n" + svm_nodes.full_report(1);
+    result += "Per-shader node statistics:\n" + shader_svm_nodes.full_report(1);
+    result += "Image fetch statistics:\n" + image_fetches.full_report(1);
   }
   else {
     result += "Profiling information not available (only works with CPU rendering)";
@@ -298,6 +433,24 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  string result = "{\n";
+  result += "  \"geometry\": " + mesh.geometry.json_report() + ",\n";
+  result += "  \"textures\": " + image.textures.json_report() + ",\n";
+  result += "  \"svm\": " + svm.json_report();
+  if (has_profiling) {
+    result += ",\n";
+    result += "  \"kernel\": " + kernel.json_report() + ",\n";
+    result += "  \"shaders\": " + shaders.json_report() + ",\n";
+    result += "  \"objects\": " + objects.json_report() + ",\n";
+    result += "  \"svm_nodes\": " + svm_nodes.json_report() + ",\n";
+    result += "  \"shader_svm_nodes\": " + shader_svm_nodes.json_report() + ",\n";
+    result += "  \"image_fetches\": " + image_fetches.json_report();
+  }
+  return result + "\n}\n";
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0) {}
 
 string UpdateTimeStats::full_report(int indent_level)
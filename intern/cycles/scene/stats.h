@@ -52,6 +52,9 @@ class NamedSizeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate machine-readable report as a JSON array. */
+  string json_report();
+
   /* Total size of all entries. */
   size_t total_size;
 
@@ -102,6 +105,9 @@ class NamedNestedSampleStats {
 
   string full_report(int indent_level = 0, uint64_t total_samples = 0);
 
+  /* Generate machine-readable report as a JSON object. */
+  string json_report();
+
   string name;
 
   /* self_samples contains only the samples that this specific event got,
@@ -131,6 +137,9 @@ class NamedSampleCountStats {
   string full_report(int indent_level = 0);
   void add(const ustring &name, uint64_t samples, uint64_t hits);
 
+  /* Generate machine-readable report as a JSON array. */
+  string json_report();
+
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
   entry_map entries;
 };
@@ -169,6 +178,9 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return full report as a JSON document. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -176,9 +188,20 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+
+  /* Size of the SVM nodes of every shader. */
+  NamedSizeStats svm;
+
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Time spent in every SVM node type, in total and broken down per shader. */
+  NamedSampleCountStats svm_nodes;
+  NamedNestedSampleStats shader_svm_nodes;
+
+  /* Number of bytes fetched from every image texture. */
+  NamedSizeStats image_fetches;
 };
 
 class UpdateTimeStats {
@@ -103,6 +103,7 @@ void SVMShaderManager::device_update_specific(Device *device,
   for (int i = 0; i < num_shaders; i++) {
     Shader *shader = scene->shaders[i];
 
+    shader->num_svm_nodes = shader_svm_nodes[i].size() - 1;
     shader->clear_modified();
     if (shader->emission_sampling != EMISSION_SAMPLING_NONE) {
       scene->light_manager->tag_update(scene, LightManager::SHADER_COMPILED);
@@ -945,6 +946,8 @@ string SVMCompiler::Summary::full_report() const
 {
   string report = "";
   report += string_printf("Number of SVM nodes: %d\n", num_svm_nodes);
+  report += string_printf("Size of SVM nodes:   %s\n",
+                          string_human_readable_size(num_svm_nodes * sizeof(int4)).c_str());
   report += string_printf("Peak stack usage:    %d\n", peak_stack_usage);
 
   report += string_printf("Time (in seconds):\n");
@@ -9,9 +9,11 @@
 #include "device/device.h"
 #include "integrator/pass_accessor_cpu.h"
 #include "integrator/path_trace.h"
+#include "kernel/svm/types.h"
 #include "scene/background.h"
 #include "scene/bake.h"
 #include "scene/camera.h"
+#include "scene/image.h"
 #include "scene/integrator.h"
 #include "scene/light.h"
 #include "scene/mesh.h"
@@ -314,9 +316,16 @@ RenderWork Session::run_update_for_next_iteration()
    * Ideally this would need to happen once in `Session::set_samples()`, but the issue there is
    * the initial configuration when Session is created where the `set_samples()` is not used.
    *
+   * The sampling pattern is configured for all samples which can be rendered, which in the time
+   * budget mode is more than the number of samples. The progress keeps reporting the number of
+   * samples from the session parameters.
+   *
    * NOTE: Unless reset was requested only allow increasing number of samples. */
-  if (did_reset || scene->integrator->get_aa_samples() < params.samples) {
-    scene->integrator->set_aa_samples(params.samples);
+  const bool use_time_budget = params.use_time_budget && params.time_limit != 0.0 &&
+                               scene->integrator->get_use_adaptive_sampling();
+  const int max_samples = RenderScheduler::get_max_num_samples(params.samples, use_time_budget);
+  if (did_reset || scene->integrator->get_aa_samples() < max_samples) {
+    scene->integrator->set_aa_samples(max_samples);
   }
 
   /* Update denoiser settings. */
@@ -341,6 +350,7 @@ RenderWork Session::run_update_for_next_iteration()
   render_scheduler_.set_num_samples(params.samples);
   render_scheduler_.set_start_sample(params.sample_offset);
   render_scheduler_.set_time_limit(params.time_limit);
+  render_scheduler_.set_time_budget(params.use_time_budget);
 
   while (have_tiles) {
     render_work = render_scheduler_.get_render_work();
@@ -400,7 +410,10 @@ RenderWork Session::run_update_for_next_iteration()
     }
 
     if (update_scene(width, height)) {
-      profiler.reset(scene->shaders.size(), scene->objects.size());
+      profiler.reset(scene->shaders.size(),
+                     scene->objects.size(),
+                     NODE_NUM,
+                     scene->image_manager->get_num_image_slots());
     }
 
     /* Unlock scene mutex before loading denoiser kernels, since that may attempt to activate
@@ -751,7 +764,7 @@ void Session::collect_statistics(RenderStats *render_stats)
 
 void Session::process_full_buffer_from_disk(string_view filename)
 {
-  path_trace_->process_full_buffer_from_disk(filename);
+  path_trace_->process_full_buffer_from_disk(filename, params.full_frame_tile_size);
 }
 
 CCL_NAMESPACE_END
@@ -50,11 +50,19 @@ class SessionParams {
    * Zero means no limit is applied. */
   double time_limit;
 
+  /* Use the time limit as a budget for reaching a uniform noise level.
+   * See RenderScheduler::set_time_budget(). */
+  bool use_time_budget;
+
   bool use_profiling;
 
   bool use_auto_tile;
   int tile_size;
 
+  /* Size of tiles in which the full-frame result of tiled rendering is read from disk, denoised
+   * and written to the output driver. Zero means the full frame is processed at once. */
+  int full_frame_tile_size;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -73,11 +81,13 @@ class SessionParams {
     pixel_size = 1;
     threads = 0;
     time_limit = 0.0;
+    use_time_budget = false;
 
     use_profiling = false;
 
     use_auto_tile = true;
     tile_size = 2048;
+    full_frame_tile_size = 0;
 
     use_resolution_divider = true;
 
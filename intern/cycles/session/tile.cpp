@@ -662,4 +662,131 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
   return true;
 }
 
+bool TileManager::open_full_buffer_from_disk(const string_view filename,
+                                             BufferParams *buffer_params,
+                                             DenoiseParams *denoise_params)
+{
+  close_full_buffer_from_disk();
+
+  read_state_.tile_in = unique_ptr<ImageInput>(ImageInput::open(filename));
+  if (!read_state_.tile_in) {
+    LOG(ERROR) << "Error opening tile file " << filename;
+    return false;
+  }
+
+  const ImageSpec &image_spec = read_state_.tile_in->spec();
+
+  BufferParams file_buffer_params;
+  if (!buffer_params_from_image_spec_atttributes(&file_buffer_params, image_spec) ||
+      !node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX))
+  {
+    close_full_buffer_from_disk();
+    return false;
+  }
+
+  if (image_spec.tile_width == 0 || image_spec.tile_height == 0) {
+    LOG(ERROR) << "Tile file " << filename << " is not tiled.";
+    close_full_buffer_from_disk();
+    return false;
+  }
+
+  read_state_.buffer_params = file_buffer_params;
+  *buffer_params = std::move(file_buffer_params);
+
+  VLOG_WORK << "Opened tile file " << filename << " for region reading.";
+
+  return true;
+}
+
+bool TileManager::read_full_buffer_region_from_disk(const int4 region,
+                                                    const int2 border,
+                                                    RenderBuffers *buffers)
+{
+  DCHECK(read_state_.tile_in);
+
+  const double time_start = time_dt();
+
+  const BufferParams &full_params = read_state_.buffer_params;
+  const int2 image_tile_size = get_full_buffer_image_tile_size();
+  if (image_tile_size.x == 0 || image_tile_size.y == 0) {
+    LOG(ERROR) << "Tile file is not tiled, can not read regions from it.";
+    return false;
+  }
+
+  /* Region of the file to read, in pixels. It starts at the image tile boundary and either ends
+   * at the image tile boundary or at the image boundary, as required by the tiled read. */
+  const int x_begin = max(0, region.x - border.x);
+  const int y_begin = max(0, region.y - border.y);
+  const int x_end = min(full_params.width, region.x + region.z + border.x);
+  const int y_end = min(full_params.height, region.y + region.w + border.y);
+
+  if (x_begin % image_tile_size.x != 0 || y_begin % image_tile_size.y != 0 ||
+      (x_end != full_params.width && x_end % image_tile_size.x != 0) ||
+      (y_end != full_params.height && y_end % image_tile_size.y != 0))
+  {
+    LOG(ERROR) << "Region at " << region.x << ", " << region.y
+               << " is not aligned to the image tiles of the tile file.";
+    return false;
+  }
+
+  BufferParams region_params = full_params;
+  region_params.width = x_end - x_begin;
+  region_params.height = y_end - y_begin;
+  region_params.window_x = region.x - x_begin;
+  region_params.window_y = region.y - y_begin;
+  region_params.window_width = min(region.z, full_params.width - region.x);
+  region_params.window_height = min(region.w, full_params.height - region.y);
+  region_params.full_x = full_params.full_x + x_begin;
+  region_params.full_y = full_params.full_y + y_begin;
+  region_params.update_offset_stride();
+
+  buffers->reset(region_params);
+
+  const int num_channels = read_state_.tile_in->spec().nchannels;
+  if (!read_state_.tile_in->read_tiles(0,
+                                       0,
+                                       x_begin,
+                                       x_end,
+                                       y_begin,
+                                       y_end,
+                                       0,
+                                       1,
+                                       0,
+                                       num_channels,
+                                       TypeDesc::FLOAT,
+                                       buffers->buffer.data()))
+  {
+    LOG(ERROR) << "Error reading pixels from the tile file "
+               << read_state_.tile_in->geterror();
+    return false;
+  }
+
+  VLOG_WORK << "Read region at " << region.x << ", " << region.y << " of the tile file in "
+            << time_dt() - time_start << " seconds.";
+
+  return true;
+}
+
+int2 TileManager::get_full_buffer_image_tile_size() const
+{
+  DCHECK(read_state_.tile_in);
+
+  const ImageSpec &image_spec = read_state_.tile_in->spec();
+  return make_int2(image_spec.tile_width, image_spec.tile_height);
+}
+
+void TileManager::close_full_buffer_from_disk()
+{
+  if (!read_state_.tile_in) {
+    return;
+  }
+
+  if (!read_state_.tile_in->close()) {
+    LOG(ERROR) << "Error closing tile file " << read_state_.tile_in->geterror();
+  }
+
+  read_state_.tile_in = nullptr;
+  read_state_.buffer_params = BufferParams();
+}
+
 CCL_NAMESPACE_END
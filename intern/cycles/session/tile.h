@@ -104,6 +104,39 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Open tiles file on disk for reading the full frame render buffer region by region, without
+   * holding the full frame in memory.
+   *
+   * The buffer parameters of the full frame and the denoise parameters are read from the file
+   * metadata. The file stays open until `close_full_buffer_from_disk()` is called.
+   *
+   * Returns true on success. */
+  bool open_full_buffer_from_disk(string_view filename,
+                                  BufferParams *buffer_params,
+                                  DenoiseParams *denoise_params);
+
+  /* Read region of the full frame render buffer from the file opened by
+   * `open_full_buffer_from_disk()`.
+   *
+   * The region is given in pixels relative to the full frame buffer and is grown by the border on
+   * all sides, clamped to the frame. The window of the resulting buffers covers the requested
+   * region, the border is only used as a context for the denoiser.
+   *
+   * The region and the border must be aligned to the image tiles of the file, see
+   * `get_full_buffer_image_tile_size()`.
+   *
+   * Returns true on success. */
+  bool read_full_buffer_region_from_disk(const int4 region,
+                                         const int2 border,
+                                         RenderBuffers *buffers);
+
+  /* Size of the image tiles of the file opened by `open_full_buffer_from_disk()`. It follows the
+   * render tile size the file was written with, so it can be smaller than IMAGE_TILE_SIZE and is
+   * not necessarily a power of two. */
+  int2 get_full_buffer_image_tile_size() const;
+
+  void close_full_buffer_from_disk();
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
@@ -173,6 +206,14 @@ class TileManager {
 
     int num_tiles_written = 0;
   } write_state_;
+
+  /* State of the region-by-region reading of the full frame buffer from a file on disk. */
+  struct {
+    /* Parameters of the full frame buffer stored in the file. */
+    BufferParams buffer_params;
+
+    unique_ptr<ImageInput> tile_in;
+  } read_state_;
 };
 
 CCL_NAMESPACE_END
@@ -33,8 +33,14 @@ void EdgeDice::reserve(int num_verts, int num_triangles)
   vert_offset = mesh->get_verts().size();
   tri_offset = mesh->num_triangles();
 
-  mesh->resize_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles());
-  mesh->reserve_mesh(mesh->get_verts().size() + num_verts, mesh->num_triangles() + num_triangles);
+  /* Triangles are written directly at the offset of their subpatch rather than appended, so that
+   * subpatches can be diced in parallel. */
+  mesh->resize_mesh(vert_offset + num_verts, tri_offset + num_triangles);
+
+  mesh->tag_triangles_modified();
+  mesh->tag_shader_modified();
+  mesh->tag_smooth_modified();
+  mesh->tag_triangle_patch_modified();
 
   Attribute *attr_vN = mesh->attributes.add(ATTR_STD_VERTEX_NORMAL);
 
@@ -57,17 +63,22 @@ void EdgeDice::set_vert(Patch *patch, int index, float2 uv)
   params.mesh->vert_patch_uv[index + vert_offset] = make_float2(uv.x, uv.y);
 }
 
-void EdgeDice::add_triangle(Patch *patch, int v0, int v1, int v2)
+void EdgeDice::set_triangle(Patch *patch, int triangle, int v0, int v1, int v2)
 {
   Mesh *mesh = params.mesh;
+  const size_t index = tri_offset + triangle;
 
-  mesh->add_triangle(v0 + vert_offset, v1 + vert_offset, v2 + vert_offset, patch->shader, true);
-  params.mesh->triangle_patch[params.mesh->num_triangles() - 1] = patch->patch_index;
+  assert(index < mesh->num_triangles());
 
-  tri_offset++;
+  mesh->triangles[index * 3 + 0] = v0 + vert_offset;
+  mesh->triangles[index * 3 + 1] = v1 + vert_offset;
+  mesh->triangles[index * 3 + 2] = v2 + vert_offset;
+  mesh->shader[index] = patch->shader;
+  mesh->smooth[index] = true;
+  mesh->triangle_patch[index] = patch->patch_index;
 }
 
-void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
+void EdgeDice::stitch_triangles(Subpatch &sub, int edge, int &triangle)
 {
   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
   int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
@@ -110,7 +121,7 @@ void EdgeDice::stitch_triangles(Subpatch &sub, int edge)
         v2 = sub.get_vert_along_grid_edge(edge, ++i);
     }
 
-    add_triangle(sub.patch, v1, v0, v2);
+    set_triangle(sub.patch, triangle++, v1, v0, v2);
   }
 }
 
@@ -143,12 +154,17 @@ void QuadDice::set_vert(Subpatch &sub, int index, float u, float v)
   EdgeDice::set_vert(sub.patch, index, map_uv(sub, u, v));
 }
 
-void QuadDice::set_side(Subpatch &sub, int edge)
+void QuadDice::set_side(Subpatch &sub, int edge, int sub_index, const int *edge_vert_owner)
 {
   int t = sub.edges[edge].T;
 
   /* set verts on the edge of the patch */
   for (int i = 0; i < t; i++) {
+    const int index = sub.get_vert_along_edge(edge, i);
+    if (edge_vert_owner[index] != sub_index) {
+      continue;
+    }
+
     float f = i / (float)t;
 
     float u, v;
@@ -172,7 +188,7 @@ void QuadDice::set_side(Subpatch &sub, int edge)
         break;
     }
 
-    set_vert(sub, sub.get_vert_along_edge(edge, i), u, v);
+    set_vert(sub, index, u, v);
   }
 }
 
@@ -210,7 +226,7 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::add_grid_verts(Subpatch &sub, int Mu, int Mv, int offset)
 {
   /* create inner grid */
   float du = 1.0f / (float)Mu;
@@ -222,25 +238,30 @@ void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
       float v = j * dv;
 
       set_vert(sub, offset + (i - 1) + (j - 1) * (Mu - 1), u, v);
+    }
+  }
+}
 
-      if (i < Mu - 1 && j < Mv - 1) {
-        int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
-        int i2 = offset + i + (j - 1) * (Mu - 1);
-        int i3 = offset + i + j * (Mu - 1);
-        int i4 = offset + (i - 1) + j * (Mu - 1);
-
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
-      }
+void QuadDice::add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset, int &triangle)
+{
+  for (int j = 1; j < Mv - 1; j++) {
+    for (int i = 1; i < Mu - 1; i++) {
+      int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
+      int i2 = offset + i + (j - 1) * (Mu - 1);
+      int i3 = offset + i + j * (Mu - 1);
+      int i4 = offset + (i - 1) + j * (Mu - 1);
+
+      set_triangle(sub.patch, triangle++, i1, i2, i3);
+      set_triangle(sub.patch, triangle++, i1, i3, i4);
     }
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::grid_size(Subpatch &sub, int &Mu, int &Mv)
 {
   /* compute inner grid size with scale factor */
-  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
-  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+  Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+  Mv = max(sub.edge_v0.T, sub.edge_v1.T);
 
 #if 0 /* Doesn't work very well, especially at grazing angles. */
   float S = scale_factor(sub, ef, Mu, Mv);
@@ -250,20 +271,38 @@ void QuadDice::dice(Subpatch &sub)
 
   Mu = max((int)ceilf(S * Mu), 2);  // XXX handle 0 & 1?
   Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
+}
+
+void QuadDice::dice_verts(Subpatch &sub, int sub_index, const int *edge_vert_owner)
+{
+  int Mu, Mv;
+  grid_size(sub, Mu, Mv);
 
   /* inner grid */
-  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
+  add_grid_verts(sub, Mu, Mv, sub.inner_grid_vert_offset);
 
   /* sides */
-  set_side(sub, 0);
-  set_side(sub, 1);
-  set_side(sub, 2);
-  set_side(sub, 3);
-
-  stitch_triangles(sub, 0);
-  stitch_triangles(sub, 1);
-  stitch_triangles(sub, 2);
-  stitch_triangles(sub, 3);
+  set_side(sub, 0, sub_index, edge_vert_owner);
+  set_side(sub, 1, sub_index, edge_vert_owner);
+  set_side(sub, 2, sub_index, edge_vert_owner);
+  set_side(sub, 3, sub_index, edge_vert_owner);
+}
+
+void QuadDice::dice_triangles(Subpatch &sub)
+{
+  int Mu, Mv;
+  grid_size(sub, Mu, Mv);
+
+  int triangle = sub.triangle_offset;
+
+  add_grid_triangles(sub, Mu, Mv, sub.inner_grid_vert_offset, triangle);
+
+  stitch_triangles(sub, 0, triangle);
+  stitch_triangles(sub, 1, triangle);
+  stitch_triangles(sub, 2, triangle);
+  stitch_triangles(sub, 3, triangle);
+
+  assert(triangle == sub.triangle_offset + sub.calc_num_triangles());
 }
 
 CCL_NAMESPACE_END
@@ -60,9 +60,9 @@ class EdgeDice {
   void reserve(int num_verts, int num_triangles);
 
   void set_vert(Patch *patch, int index, float2 uv);
-  void add_triangle(Patch *patch, int v0, int v1, int v2);
+  void set_triangle(Patch *patch, int triangle, int v0, int v1, int v2);
 
-  void stitch_triangles(Subpatch &sub, int edge);
+  void stitch_triangles(Subpatch &sub, int edge, int &triangle);
 };
 
 /* Quad EdgeDice */
@@ -76,14 +76,22 @@ class QuadDice : public EdgeDice {
   float2 map_uv(Subpatch &sub, float u, float v);
   void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid_verts(Subpatch &sub, int Mu, int Mv, int offset);
+  void add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset, int &triangle);
 
-  void set_side(Subpatch &sub, int edge);
+  void set_side(Subpatch &sub, int edge, int sub_index, const int *edge_vert_owner);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
-  void dice(Subpatch &sub);
+  void grid_size(Subpatch &sub, int &Mu, int &Mv);
+
+  /* Dicing is done in two passes over all subpatches, each of which may run in parallel. First
+   * the vertices are evaluated, where vertices on edges shared by multiple subpatches are only
+   * written by the subpatch in `edge_vert_owner`. Then the triangles are written at the offset of
+   * the subpatch, stitching edges using the final vertex positions. */
+  void dice_verts(Subpatch &sub, int sub_index, const int *edge_vert_owner);
+  void dice_triangles(Subpatch &sub);
 };
 
 CCL_NAMESPACE_END
@@ -13,7 +13,9 @@
 #include "util/foreach.h"
 #include "util/hash.h"
 #include "util/math.h"
+#include "util/tbb.h"
 #include "util/types.h"
+#include "util/unique_ptr.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -22,6 +24,7 @@ CCL_NAMESPACE_BEGIN
 #define DSPLIT_NON_UNIFORM -1
 #define STITCH_NGON_CENTER_VERT_INDEX_OFFSET 0x60000000
 #define STITCH_NGON_SPLIT_EDGE_CENTER_VERT_TAG (0x60000000 - 1)
+#define DSPLIT_FACES_PER_CHUNK 64
 
 DiagSplit::DiagSplit(const SubdParams &params_) : params(params_) {}
 
@@ -323,11 +326,14 @@ Edge *DiagSplit::alloc_edge()
   return &edges.back();
 }
 
-void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+void DiagSplit::split_faces(Patch *patches,
+                            size_t patches_byte_stride,
+                            int face_begin,
+                            int face_end)
 {
   int patch_index = 0;
 
-  for (int f = 0; f < params.mesh->get_num_subd_faces(); f++) {
+  for (int f = face_begin; f < face_end; f++) {
     Mesh::SubdFace face = params.mesh->get_subd_face(f);
 
     Patch *patch = (Patch *)(((char *)patches) + patch_index * patches_byte_stride);
@@ -343,6 +349,64 @@ void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
       split_ngon(face, patch, patches_byte_stride);
     }
   }
+}
+
+void DiagSplit::merge_chunk(DiagSplit &chunk)
+{
+  /* Vertices allocated by the chunk follow the ones of the previous chunks. */
+  const int vert_offset = alloc_verts(chunk.num_alloced_verts);
+
+  foreach (Edge &edge, chunk.edges) {
+    if (edge.start_vert_index >= 0) {
+      edge.start_vert_index += vert_offset;
+    }
+    if (edge.end_vert_index >= 0) {
+      edge.end_vert_index += vert_offset;
+    }
+  }
+
+  subpatches.insert(subpatches.end(), chunk.subpatches.begin(), chunk.subpatches.end());
+  chunk_edges.push_back(std::move(chunk.edges));
+}
+
+void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+{
+  const int num_faces = params.mesh->get_num_subd_faces();
+  const int num_chunks = divide_up(num_faces, DSPLIT_FACES_PER_CHUNK);
+
+  /* Index of the first patch of every chunk of faces. */
+  vector<int> chunk_patch_index(num_chunks);
+  int patch_index = 0;
+
+  for (int f = 0; f < num_faces; f++) {
+    if (f % DSPLIT_FACES_PER_CHUNK == 0) {
+      chunk_patch_index[f / DSPLIT_FACES_PER_CHUNK] = patch_index;
+    }
+
+    Mesh::SubdFace face = params.mesh->get_subd_face(f);
+    patch_index += (face.is_quad()) ? 1 : face.num_corners;
+  }
+
+  /* Faces are split independently of each other, so chunks of faces are split in parallel. Merging
+   * the chunks in face order gives the same vertex numbering as splitting all faces in order. */
+  vector<unique_ptr<DiagSplit>> chunks(num_chunks);
+
+  parallel_for(0, num_chunks, [&](int chunk_index) {
+    const int face_begin = chunk_index * DSPLIT_FACES_PER_CHUNK;
+    const int face_end = min(face_begin + DSPLIT_FACES_PER_CHUNK, num_faces);
+    Patch *chunk_patches = (Patch *)(((char *)patches) +
+                                     chunk_patch_index[chunk_index] * patches_byte_stride);
+
+    chunks[chunk_index] = make_unique<DiagSplit>(params);
+    chunks[chunk_index]->split_faces(chunk_patches, patches_byte_stride, face_begin, face_end);
+  });
+
+  /* Reserve up front, reallocating would copy the edges of merged chunks and leave the
+   * subpatches referencing freed ones. */
+  chunk_edges.reserve(chunk_edges.size() + num_chunks);
+  for (unique_ptr<DiagSplit> &chunk : chunks) {
+    merge_chunk(*chunk);
+  }
 
   params.mesh->vert_to_stitching_key_map.clear();
   params.mesh->vert_stitching_map.clear();
@@ -591,16 +655,23 @@ void DiagSplit::post_split()
 {
   int num_stitch_verts = 0;
 
+  vector<Edge *> all_edges;
+  foreach (deque<Edge> &edges_chunk, chunk_edges) {
+    foreach (Edge &edge, edges_chunk) {
+      all_edges.push_back(&edge);
+    }
+  }
+
   /* All patches are now split, and all T values known. */
 
-  foreach (Edge &edge, edges) {
-    if (edge.second_vert_index < 0) {
-      edge.second_vert_index = alloc_verts(edge.T - 1);
+  foreach (Edge *edge, all_edges) {
+    if (edge->second_vert_index < 0) {
+      edge->second_vert_index = alloc_verts(edge->T - 1);
     }
 
-    if (edge.is_stitch_edge) {
+    if (edge->is_stitch_edge) {
       num_stitch_verts = max(num_stitch_verts,
-                             max(edge.stitch_start_vert_index, edge.stitch_end_vert_index));
+                             max(edge->stitch_start_vert_index, edge->stitch_end_vert_index));
     }
   }
 
@@ -616,80 +687,80 @@ void DiagSplit::post_split()
   typedef unordered_map<pair<int, int>, int, pair_hasher> edge_stitch_verts_map_t;
   edge_stitch_verts_map_t edge_stitch_verts_map;
 
-  foreach (Edge &edge, edges) {
-    if (edge.is_stitch_edge) {
-      if (edge.stitch_edge_T == 0) {
-        edge.stitch_edge_T = edge.T;
+  foreach (Edge *edge, all_edges) {
+    if (edge->is_stitch_edge) {
+      if (edge->stitch_edge_T == 0) {
+        edge->stitch_edge_T = edge->T;
       }
 
-      if (edge_stitch_verts_map.find(edge.stitch_edge_key) == edge_stitch_verts_map.end()) {
-        edge_stitch_verts_map[edge.stitch_edge_key] = num_stitch_verts;
-        num_stitch_verts += edge.stitch_edge_T - 1;
+      if (edge_stitch_verts_map.find(edge->stitch_edge_key) == edge_stitch_verts_map.end()) {
+        edge_stitch_verts_map[edge->stitch_edge_key] = num_stitch_verts;
+        num_stitch_verts += edge->stitch_edge_T - 1;
       }
     }
   }
 
   /* Set start and end indices for edges generated from a split. */
-  foreach (Edge &edge, edges) {
-    if (edge.start_vert_index < 0) {
+  foreach (Edge *edge, all_edges) {
+    if (edge->start_vert_index < 0) {
       /* Fix up offsets. */
-      if (edge.top_indices_decrease) {
-        edge.top_offset = edge.top->T - edge.top_offset;
+      if (edge->top_indices_decrease) {
+        edge->top_offset = edge->top->T - edge->top_offset;
       }
 
-      edge.start_vert_index = edge.top->get_vert_along_edge(edge.top_offset);
+      edge->start_vert_index = edge->top->get_vert_along_edge(edge->top_offset);
     }
 
-    if (edge.end_vert_index < 0) {
-      if (edge.bottom_indices_decrease) {
-        edge.bottom_offset = edge.bottom->T - edge.bottom_offset;
+    if (edge->end_vert_index < 0) {
+      if (edge->bottom_indices_decrease) {
+        edge->bottom_offset = edge->bottom->T - edge->bottom_offset;
       }
 
-      edge.end_vert_index = edge.bottom->get_vert_along_edge(edge.bottom_offset);
+      edge->end_vert_index = edge->bottom->get_vert_along_edge(edge->bottom_offset);
     }
   }
 
   int vert_offset = params.mesh->verts.size();
 
   /* Add verts to stitching map. */
-  foreach (const Edge &edge, edges) {
-    if (edge.is_stitch_edge) {
-      int second_stitch_vert_index = edge_stitch_verts_map[edge.stitch_edge_key];
+  foreach (const Edge *edge, all_edges) {
+    if (edge->is_stitch_edge) {
+      int second_stitch_vert_index = edge_stitch_verts_map[edge->stitch_edge_key];
 
-      for (int i = 0; i <= edge.T; i++) {
+      for (int i = 0; i <= edge->T; i++) {
         /* Get proper stitching key. */
         int key;
 
         if (i == 0) {
-          key = edge.stitch_start_vert_index;
+          key = edge->stitch_start_vert_index;
         }
-        else if (i == edge.T) {
-          key = edge.stitch_end_vert_index;
+        else if (i == edge->T) {
+          key = edge->stitch_end_vert_index;
         }
         else {
-          key = second_stitch_vert_index + i - 1 + edge.stitch_offset;
+          key = second_stitch_vert_index + i - 1 + edge->stitch_offset;
         }
 
         if (key == STITCH_NGON_SPLIT_EDGE_CENTER_VERT_TAG) {
           if (i == 0) {
-            key = second_stitch_vert_index - 1 + edge.stitch_offset;
+            key = second_stitch_vert_index - 1 + edge->stitch_offset;
           }
-          else if (i == edge.T) {
-            key = second_stitch_vert_index - 1 + edge.T;
+          else if (i == edge->T) {
+            key = second_stitch_vert_index - 1 + edge->T;
           }
         }
-        else if (key < 0 && edge.top) { /* ngon spoke edge */
-          int s = edge_stitch_verts_map[edge.top->stitch_edge_key];
-          if (edge.stitch_top_offset >= 0) {
-            key = s - 1 + edge.stitch_top_offset;
+        else if (key < 0 && edge->top) { /* ngon spoke edge */
+          int s = edge_stitch_verts_map[edge->top->stitch_edge_key];
+          if (edge->stitch_top_offset >= 0) {
+            key = s - 1 + edge->stitch_top_offset;
           }
           else {
-            key = s - 1 + edge.top->stitch_edge_T + edge.stitch_top_offset;
+            key = s - 1 + edge->top->stitch_edge_T + edge->stitch_top_offset;
           }
         }
 
         /* Get real vert index. */
-        int vert = edge.get_vert_along_edge(i) + vert_offset;
+        int vert = edge->get_vert_along_edge(i) + vert_offset;
 
         /* Add to map */
         if (params.mesh->vert_to_stitching_key_map.find(vert) ==
@@ -708,14 +779,6 @@ void DiagSplit::post_split()
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    subpatches[i].inner_grid_vert_offset = num_verts;
-    num_verts += subpatches[i].calc_num_inner_verts();
-    num_triangles += subpatches[i].calc_num_triangles();
-  }
-
-  dice.reserve(num_verts, num_triangles);
-
   for (size_t i = 0; i < subpatches.size(); i++) {
     Subpatch &sub = subpatches[i];
 
@@ -724,12 +787,40 @@ void DiagSplit::post_split()
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
 
-    dice.dice(sub);
+    sub.inner_grid_vert_offset = num_verts;
+    sub.triangle_offset = num_triangles;
+    num_verts += sub.calc_num_inner_verts();
+    num_triangles += sub.calc_num_triangles();
+  }
+
+  dice.reserve(num_verts, num_triangles);
+
+  /* Vertices along edges are shared with neighboring subpatches. Each of them is only written by
+   * the last subpatch along it, the same one that would write it last when dicing in order. */
+  vector<int> edge_vert_owner(num_alloced_verts, -1);
+
+  for (size_t i = 0; i < subpatches.size(); i++) {
+    const Subpatch &sub = subpatches[i];
+
+    for (int edge = 0; edge < 4; edge++) {
+      for (int n = 0; n < sub.edges[edge].T; n++) {
+        edge_vert_owner[sub.get_vert_along_edge(edge, n)] = (int)i;
+      }
+    }
   }
 
+  parallel_for(size_t(0), subpatches.size(), [&](size_t i) {
+    dice.dice_verts(subpatches[i], (int)i, edge_vert_owner.data());
+  });
+
+  parallel_for(size_t(0), subpatches.size(), [&](size_t i) {
+    dice.dice_triangles(subpatches[i]);
+  });
+
   /* Cleanup */
   subpatches.clear();
   edges.clear();
+  chunk_edges.clear();
 }
 
 CCL_NAMESPACE_END
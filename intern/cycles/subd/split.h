@@ -30,6 +30,10 @@ class DiagSplit {
   vector<Subpatch> subpatches;
   /* `deque` is used so that element pointers remain valid when size is changed. */
   deque<Edge> edges;
+  /* Edges of the chunks of faces which were split in parallel, in face order. Moving a `deque`
+   * keeps element pointers valid, so subpatches can keep referencing them. The vector must not
+   * reallocate while subpatches reference them, as that may copy the `deque` instead. */
+  vector<deque<Edge>> chunk_edges;
 
   float3 to_world(Patch *patch, float2 uv);
   int T(Patch *patch, float2 Pstart, float2 Pend, bool recursive_resolve = false);
@@ -45,6 +49,9 @@ class DiagSplit {
   int num_alloced_verts = 0;
   int alloc_verts(int n); /* Returns start index of new verts. */
 
+  void split_faces(Patch *patches, size_t patches_byte_stride, int face_begin, int face_end);
+  void merge_chunk(DiagSplit &chunk);
+
  public:
   Edge *alloc_edge();
 
@@ -0,0 +1,181 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "bvh/build.h"
+#include "bvh/node.h"
+#include "bvh/params.h"
+
+#include "device/device.h"
+
+#include "scene/attribute.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/scene.h"
+
+#include "util/array.h"
+#include "util/map.h"
+#include "util/progress.h"
+#include "util/stats.h"
+#include "util/vector.h"
+
+#include <algorithm>
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Triangle indices in the test mesh. */
+enum {
+  TRIANGLE_STATIC = 0,
+  TRIANGLE_PARTIALLY_MOVING = 1,
+  TRIANGLE_FULLY_MOVING = 2,
+};
+
+class BVHBuildMotionStepsTest : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  SceneParams scene_params;
+  Scene *scene;
+  Progress progress;
+  vector<Object *> objects;
+
+  virtual void SetUp()
+  {
+    device_cpu = Device::create(device_info, stats, profiler);
+    scene = new Scene(scene_params, device_cpu);
+
+    /* Three unit triangles with motion steps at the start, center and end of the shutter:
+     * - One which does not move.
+     * - One which does not move in the first half, and moves fast in the second half.
+     * - One which moves fast during the whole shutter time. */
+    Mesh *mesh = scene->create_node<Mesh>();
+    mesh->set_motion_steps(3);
+    mesh->set_use_motion_blur(true);
+    mesh->reserve_mesh(9, 3);
+    for (int i = 0; i < 3; i++) {
+      const float3 offset = make_float3(0.0f, 0.0f, i * 100.0f);
+      mesh->add_vertex(offset);
+      mesh->add_vertex(offset + make_float3(1.0f, 0.0f, 0.0f));
+      mesh->add_vertex(offset + make_float3(0.0f, 1.0f, 0.0f));
+      mesh->add_triangle(i * 3 + 0, i * 3 + 1, i * 3 + 2, 0, false);
+    }
+
+    const array<float3> &verts = mesh->get_verts();
+    const size_t num_verts = verts.size();
+    Attribute *attr_mP = mesh->attributes.add(ATTR_STD_MOTION_VERTEX_POSITION);
+    float3 *start_verts = attr_mP->data_float3();
+    float3 *end_verts = start_verts + num_verts;
+
+    const float3 motion = make_float3(10.0f, 0.0f, 0.0f);
+    for (size_t v = 0; v < num_verts; v++) {
+      switch (v / 3) {
+        case TRIANGLE_STATIC:
+          start_verts[v] = verts[v];
+          end_verts[v] = verts[v];
+          break;
+        case TRIANGLE_PARTIALLY_MOVING:
+          start_verts[v] = verts[v];
+          end_verts[v] = verts[v] + motion;
+          break;
+        case TRIANGLE_FULLY_MOVING:
+          start_verts[v] = verts[v] - motion;
+          end_verts[v] = verts[v] + motion;
+          break;
+      }
+    }
+
+    Object *object = scene->create_node<Object>();
+    object->set_geometry(mesh);
+    objects.push_back(object);
+  }
+
+  virtual void TearDown()
+  {
+    delete scene;
+    delete device_cpu;
+  }
+
+  /* Build a BVH with 2 motion steps, which gives 4 time segments, and return the time ranges of
+   * the references of every triangle, sorted by time. */
+  map<int, vector<float2>> build_time_ranges(const float merge_tolerance)
+  {
+    BVHParams params;
+    params.use_spatial_split = false;
+    params.num_motion_triangle_steps = 2;
+    params.motion_step_merge_tolerance = merge_tolerance;
+
+    array<int> prim_type;
+    array<int> prim_index;
+    array<int> prim_object;
+    array<float2> prim_time;
+    BVHBuild build(objects, prim_type, prim_index, prim_object, prim_time, params, progress);
+    BVHNode *root = build.run();
+    EXPECT_NE(root, nullptr);
+    if (root) {
+      root->deleteSubtree();
+    }
+
+    map<int, vector<float2>> time_ranges;
+    EXPECT_EQ(prim_time.size(), prim_index.size());
+    for (size_t i = 0; i < prim_index.size(); i++) {
+      time_ranges[prim_index[i]].push_back(prim_time[i]);
+    }
+    for (auto &[prim, ranges] : time_ranges) {
+      std::sort(ranges.begin(), ranges.end(), [](const float2 a, const float2 b) {
+        return a.x < b.x;
+      });
+    }
+    return time_ranges;
+  }
+};
+
+void expect_time_ranges(const vector<float2> &ranges, const vector<float2> &expected)
+{
+  ASSERT_EQ(ranges.size(), expected.size());
+  for (size_t i = 0; i < ranges.size(); i++) {
+    EXPECT_FLOAT_EQ(ranges[i].x, expected[i].x);
+    EXPECT_FLOAT_EQ(ranges[i].y, expected[i].y);
+  }
+}
+
+}  // namespace
+
+/* Time segments are merged only where the primitive barely moves. */
+TEST_F(BVHBuildMotionStepsTest, MergeStaticSegments)
+{
+  map<int, vector<float2>> time_ranges = build_time_ranges(1.1f);
+  ASSERT_EQ(time_ranges.size(), 3);
+
+  expect_time_ranges(time_ranges[TRIANGLE_STATIC], {make_float2(0.0f, 1.0f)});
+  expect_time_ranges(
+      time_ranges[TRIANGLE_PARTIALLY_MOVING],
+      {make_float2(0.0f, 0.5f), make_float2(0.5f, 0.75f), make_float2(0.75f, 1.0f)});
+  expect_time_ranges(time_ranges[TRIANGLE_FULLY_MOVING],
+                     {make_float2(0.0f, 0.25f),
+                      make_float2(0.25f, 0.5f),
+                      make_float2(0.5f, 0.75f),
+                      make_float2(0.75f, 1.0f)});
+}
+
+/* A zero tolerance disables merging, every primitive gets one reference per time segment. */
+TEST_F(BVHBuildMotionStepsTest, NoMerge)
+{
+  map<int, vector<float2>> time_ranges = build_time_ranges(0.0f);
+  ASSERT_EQ(time_ranges.size(), 3);
+
+  const vector<float2> all_segments = {make_float2(0.0f, 0.25f),
+                                       make_float2(0.25f, 0.5f),
+                                       make_float2(0.5f, 0.75f),
+                                       make_float2(0.75f, 1.0f)};
+  expect_time_ranges(time_ranges[TRIANGLE_STATIC], all_segments);
+  expect_time_ranges(time_ranges[TRIANGLE_PARTIALLY_MOVING], all_segments);
+  expect_time_ranges(time_ranges[TRIANGLE_FULLY_MOVING], all_segments);
+}
+
+CCL_NAMESPACE_END
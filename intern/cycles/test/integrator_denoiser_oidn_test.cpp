@@ -0,0 +1,126 @@
+/* SPDX-FileCopyrightText: 2011-2022 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+#include "integrator/denoiser_oidn.h"
+#include "session/buffers.h"
+
+#include "util/hash.h"
+#include "util/openimagedenoise.h"
+#include "util/profiling.h"
+#include "util/stats.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Large enough to be split into multiple tiles with the smallest memory limit. */
+constexpr int IMAGE_WIDTH = 600;
+constexpr int IMAGE_HEIGHT = 300;
+
+BufferParams make_buffer_params()
+{
+  BufferParams buffer_params;
+  buffer_params.width = IMAGE_WIDTH;
+  buffer_params.height = IMAGE_HEIGHT;
+  buffer_params.window_width = IMAGE_WIDTH;
+  buffer_params.window_height = IMAGE_HEIGHT;
+  buffer_params.full_width = IMAGE_WIDTH;
+  buffer_params.full_height = IMAGE_HEIGHT;
+
+  BufferPass noisy_pass;
+  noisy_pass.type = PASS_COMBINED;
+  noisy_pass.mode = PassMode::NOISY;
+  noisy_pass.offset = 0;
+
+  BufferPass denoised_pass;
+  denoised_pass.type = PASS_COMBINED;
+  denoised_pass.mode = PassMode::DENOISED;
+  denoised_pass.offset = 4;
+
+  buffer_params.passes = {noisy_pass, denoised_pass};
+  buffer_params.update_passes();
+
+  return buffer_params;
+}
+
+/* Denoise a noisy gradient with the given memory limit, returning the denoised pass. */
+vector<float> denoise_gradient(Device *device, const int max_memory)
+{
+  const BufferParams buffer_params = make_buffer_params();
+
+  RenderBuffers render_buffers(device);
+  render_buffers.reset(buffer_params);
+
+  float *buffer = render_buffers.buffer.data();
+  const int pass_stride = buffer_params.pass_stride;
+  for (int y = 0; y < IMAGE_HEIGHT; y++) {
+    for (int x = 0; x < IMAGE_WIDTH; x++) {
+      float *pixel = buffer + (int64_t(y) * IMAGE_WIDTH + x) * pass_stride;
+      const float noise = hash_uint2_to_float(x, y) - 0.5f;
+      const float value = float(x) / IMAGE_WIDTH + 0.2f * noise;
+      pixel[0] = value;
+      pixel[1] = value;
+      pixel[2] = value;
+      pixel[3] = 1.0f;
+    }
+  }
+
+  DenoiseParams denoise_params;
+  denoise_params.use = true;
+  denoise_params.type = DENOISER_OPENIMAGEDENOISE;
+  denoise_params.use_pass_albedo = false;
+  denoise_params.use_pass_normal = false;
+  denoise_params.prefilter = DENOISER_PREFILTER_NONE;
+  denoise_params.max_memory = max_memory;
+
+  OIDNDenoiser denoiser(device, denoise_params);
+  EXPECT_TRUE(denoiser.denoise_buffer(buffer_params, &render_buffers, 1, false));
+
+  const int denoised_offset = buffer_params.get_pass_offset(PASS_COMBINED, PassMode::DENOISED);
+
+  vector<float> denoised;
+  denoised.reserve(IMAGE_WIDTH * IMAGE_HEIGHT * 3);
+  for (int64_t i = 0; i < int64_t(IMAGE_WIDTH) * IMAGE_HEIGHT; i++) {
+    const float *pixel = buffer + i * pass_stride + denoised_offset;
+    denoised.push_back(pixel[0]);
+    denoised.push_back(pixel[1]);
+    denoised.push_back(pixel[2]);
+  }
+
+  return denoised;
+}
+
+}  // namespace
+
+/* Denoising in tiles has an overlap around every tile and uses the exposure of the whole buffer,
+ * so the result is expected to match the denoising of the whole buffer closely. */
+TEST(integrator_denoiser_oidn, TiledMatchesUntiled)
+{
+  if (!openimagedenoise_supported()) {
+    return;
+  }
+
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  unique_ptr<Device> device(Device::create(device_info, stats, profiler));
+
+  /* One megabyte forces the smallest tile size, which splits the image into six tiles. */
+  const vector<float> untiled = denoise_gradient(device.get(), 0);
+  const vector<float> tiled = denoise_gradient(device.get(), 1);
+
+  ASSERT_EQ(untiled.size(), tiled.size());
+
+  double total_difference = 0.0;
+  for (size_t i = 0; i < untiled.size(); i++) {
+    EXPECT_NEAR(untiled[i], tiled[i], 5e-3f) << "at pixel " << i / 3;
+    total_difference += fabs(double(untiled[i]) - double(tiled[i]));
+  }
+  EXPECT_LT(total_difference / untiled.size(), 5e-4);
+}
+
+CCL_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include "testing/testing.h"
 
 #include "integrator/render_scheduler.h"
+#include "scene/integrator.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -22,4 +23,12 @@ TEST(IntegratorRenderScheduler, calculate_resolution_for_divider)
   EXPECT_EQ(calculate_resolution_for_divider(1920, 1080, 4), 360);
 }
 
+TEST(IntegratorRenderScheduler, get_max_num_samples)
+{
+  EXPECT_EQ(RenderScheduler::get_max_num_samples(128, false), 128);
+  EXPECT_EQ(RenderScheduler::get_max_num_samples(128, true), 256);
+  EXPECT_EQ(RenderScheduler::get_max_num_samples(Integrator::MAX_SAMPLES, true),
+            Integrator::MAX_SAMPLES);
+}
+
 CCL_NAMESPACE_END
@@ -0,0 +1,485 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/* Micro-benchmark of individual CPU kernels.
+ *
+ * Every kernel is executed on a set of canned integrator states which are captured from a small
+ * procedural scene right before the kernel is scheduled by the megakernel. This allows to see
+ * regressions of a single kernel and of a single micro-architecture variant of it, which are
+ * otherwise hidden in the full-frame render time. */
+
+#include "testing/testing.h"
+
+#include "device/cpu/kernel.h"
+#include "device/cpu/kernel_thread_globals.h"
+#include "device/device.h"
+
+#include "kernel/integrator/state.h"
+
+#include "scene/background.h"
+#include "scene/camera.h"
+#include "scene/colorspace.h"
+#include "scene/film.h"
+#include "scene/light.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/scene.h"
+#include "scene/shader.h"
+#include "scene/shader_graph.h"
+#include "scene/shader_nodes.h"
+
+#include "session/buffers.h"
+
+#include "util/debug.h"
+#include "util/half.h"
+#include "util/progress.h"
+#include "util/stats.h"
+#include "util/time.h"
+#include "util/vector.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#  define HAVE_CPU_CYCLE_COUNTER
+#endif
+
+#include <cstdio>
+#include <cstring>
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Resolution of the canned image, every pixel provides one integrator state. */
+constexpr int IMAGE_SIZE = 64;
+
+/* Number of times every kernel is executed on the whole set of canned states. */
+constexpr int NUM_ITERATIONS = 8;
+
+/* Resolution of the procedural height field which is being rendered. */
+constexpr int GRID_RESOLUTION = 256;
+
+struct KernelVariant {
+  const char *uarch_name;
+  bool sse2;
+  bool sse41;
+  bool avx2;
+};
+
+/* Names match the ones reported by CPUKernelFunction::get_uarch_name(). Variants which are not
+ * compiled in or not supported by the CPU are skipped. */
+const KernelVariant KERNEL_VARIANTS[] = {
+    {"default", false, false, false},
+    {"SSE2", true, false, false},
+    {"SSE4.1", true, true, false},
+    {"AVX2", true, true, true},
+};
+
+inline uint64_t cpu_cycles()
+{
+#ifdef HAVE_CPU_CYCLE_COUNTER
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/* Run the kernel which is queued for the main path of the state. Returns false when the path is
+ * terminated or the queued kernel is not handled here. */
+bool run_queued_kernel(const CPUKernels &kernels,
+                       const KernelGlobalsCPU *kg,
+                       IntegratorStateCPU *state,
+                       float *render_buffer)
+{
+  switch (INTEGRATOR_STATE(state, path, queued_kernel)) {
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST:
+      kernels.integrator_intersect_closest(kg, state, render_buffer);
+      return true;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK:
+      kernels.integrator_intersect_volume_stack(kg, state);
+      return true;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_BACKGROUND:
+      kernels.integrator_shade_background(kg, state, render_buffer);
+      return true;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT:
+      kernels.integrator_shade_light(kg, state, render_buffer);
+      return true;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE:
+      kernels.integrator_shade_surface(kg, state, render_buffer);
+      return true;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME:
+      kernels.integrator_shade_volume(kg, state, render_buffer);
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+class KernelCPUPerformance : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  SceneParams scene_params;
+  Scene *scene;
+  Progress progress;
+
+  BufferParams buffer_params;
+  RenderBuffers *render_buffers;
+  vector<CPUKernelThreadGlobals> kernel_thread_globals;
+
+  virtual void SetUp()
+  {
+    ColorSpaceManager::init_fallback_config();
+
+    /* The benchmark is single threaded, so that the timing is per-core. */
+    device_info.cpu_threads = 1;
+    device_cpu = Device::create(device_info, stats, profiler);
+    scene = new Scene(scene_params, device_cpu);
+    render_buffers = nullptr;
+  }
+
+  virtual void TearDown()
+  {
+    DebugFlags().cpu.reset();
+
+    kernel_thread_globals.clear();
+    delete render_buffers;
+    delete scene;
+    delete device_cpu;
+  }
+
+  /* Height field lit by a point light, optionally inside of a homogeneous world volume. */
+  void build_scene(const bool use_volume)
+  {
+    Mesh *mesh = scene->create_node<Mesh>();
+    array<Node *> used_shaders;
+    used_shaders.push_back_slow(scene->default_surface);
+    mesh->set_used_shaders(used_shaders);
+
+    const int num_verts_side = GRID_RESOLUTION + 1;
+    mesh->reserve_mesh(num_verts_side * num_verts_side, GRID_RESOLUTION * GRID_RESOLUTION * 2);
+    for (int y = 0; y < num_verts_side; y++) {
+      for (int x = 0; x < num_verts_side; x++) {
+        const float u = (float)x / GRID_RESOLUTION * 4.0f - 2.0f;
+        const float v = (float)y / GRID_RESOLUTION * 4.0f - 2.0f;
+        mesh->add_vertex(make_float3(u, v, 0.1f * sinf(u * 12.0f) * cosf(v * 9.0f)));
+      }
+    }
+    for (int y = 0; y < GRID_RESOLUTION; y++) {
+      for (int x = 0; x < GRID_RESOLUTION; x++) {
+        const int v0 = y * num_verts_side + x;
+        mesh->add_triangle(v0, v0 + 1, v0 + num_verts_side + 1, 0, true);
+        mesh->add_triangle(v0, v0 + num_verts_side + 1, v0 + num_verts_side, 0, true);
+      }
+    }
+
+    Object *object = scene->create_node<Object>();
+    object->set_geometry(mesh);
+    object->set_tfm(transform_identity());
+
+    {
+      ShaderGraph *graph = new ShaderGraph();
+      EmissionNode *emission = graph->create_node<EmissionNode>();
+      emission->set_color(one_float3());
+      emission->set_strength(1.0f);
+      graph->add(emission);
+      graph->connect(emission->output("Emission"), graph->output()->input("Surface"));
+
+      Shader *shader = scene->create_node<Shader>();
+      shader->name = "benchmark_light";
+      shader->set_graph(graph);
+      shader->tag_update(scene);
+
+      Light *light = scene->create_node<Light>();
+      light->set_light_type(LIGHT_POINT);
+      light->set_co(make_float3(1.0f, 1.0f, 2.0f));
+      light->set_strength(make_float3(100.0f, 100.0f, 100.0f));
+      light->set_size(0.1f);
+      light->set_shader(shader);
+    }
+
+    {
+      ShaderGraph *graph = new ShaderGraph();
+      BackgroundNode *background = graph->create_node<BackgroundNode>();
+      background->set_color(make_float3(0.05f, 0.05f, 0.05f));
+      graph->add(background);
+      graph->connect(background->output("Background"), graph->output()->input("Surface"));
+
+      if (use_volume) {
+        ScatterVolumeNode *scatter = graph->create_node<ScatterVolumeNode>();
+        scatter->set_density(0.2f);
+        graph->add(scatter);
+        graph->connect(scatter->output("Volume"), graph->output()->input("Volume"));
+      }
+
+      Shader *shader = scene->create_node<Shader>();
+      shader->name = "benchmark_background";
+      shader->set_graph(graph);
+      shader->tag_update(scene);
+      scene->background->set_shader(shader);
+    }
+
+    /* Camera above the height field, looking down. */
+    Camera *camera = scene->camera;
+    camera->set_full_width(IMAGE_SIZE);
+    camera->set_full_height(IMAGE_SIZE);
+    camera->set_screen_size(IMAGE_SIZE, IMAGE_SIZE);
+    camera->set_matrix(transform_translate(0.0f, 0.0f, 3.0f) * transform_scale(1.0f, 1.0f, -1.0f));
+    camera->compute_auto_viewplane();
+    camera->need_flags_update = true;
+
+    scene->film->update_passes(scene, false);
+
+    buffer_params.width = IMAGE_SIZE;
+    buffer_params.height = IMAGE_SIZE;
+    buffer_params.window_width = IMAGE_SIZE;
+    buffer_params.window_height = IMAGE_SIZE;
+    buffer_params.full_width = IMAGE_SIZE;
+    buffer_params.full_height = IMAGE_SIZE;
+    buffer_params.update_passes(scene->passes);
+
+    ASSERT_TRUE(scene->load_kernels(progress));
+    scene->update(progress);
+    ASSERT_FALSE(progress.get_error());
+
+    render_buffers = new RenderBuffers(device_cpu);
+    render_buffers->reset(buffer_params);
+    render_buffers->zero();
+
+    device_cpu->get_cpu_kernel_thread_globals(kernel_thread_globals);
+  }
+
+  /* Capture states of all pixels right before the given kernel is executed for the first time.
+   * Pixels whose path never reaches the kernel do not provide a state. */
+  vector<IntegratorStateCPU> capture_states(const DeviceKernel kernel)
+  {
+    const CPUKernels &kernels = Device::get_cpu_kernels();
+    const KernelGlobalsCPU *kg = &kernel_thread_globals[0];
+    float *render_buffer = render_buffers->buffer.data();
+
+    vector<IntegratorStateCPU> states;
+    IntegratorStateCPU *state = new IntegratorStateCPU();
+
+    for (int y = 0; y < IMAGE_SIZE; y++) {
+      for (int x = 0; x < IMAGE_SIZE; x++) {
+        KernelWorkTile work_tile;
+        memset(&work_tile, 0, sizeof(work_tile));
+        work_tile.x = x;
+        work_tile.y = y;
+        work_tile.w = 1;
+        work_tile.h = 1;
+        work_tile.num_samples = 1;
+        work_tile.offset = buffer_params.offset;
+        work_tile.stride = buffer_params.stride;
+
+        if (!kernels.integrator_init_from_camera(kg, state, &work_tile, render_buffer)) {
+          continue;
+        }
+
+        /* Limit the number of kernels, so that a path bouncing forever can not stall. */
+        for (int step = 0; step < 16; step++) {
+          if (INTEGRATOR_STATE(state, path, queued_kernel) == kernel) {
+            states.push_back(*state);
+            break;
+          }
+          if (!run_queued_kernel(kernels, kg, state, render_buffer)) {
+            break;
+          }
+        }
+      }
+    }
+
+    delete state;
+    return states;
+  }
+
+  static void print_result(const char *kernel_name,
+                           const char *uarch_name,
+                           const char *unit,
+                           const size_t num_items,
+                           const double time,
+                           const uint64_t cycles)
+  {
+    printf("%-34s %-8s %10.3f M%s/s",
+           kernel_name,
+           uarch_name,
+           (time > 0.0) ? num_items / time * 1e-6 : 0.0,
+           unit);
+#ifdef HAVE_CPU_CYCLE_COUNTER
+    printf("  %10.1f cycles/%s", (double)cycles / num_items, unit);
+#else
+    (void)cycles;
+#endif
+    printf("\n");
+  }
+
+  /* Run the integrator kernel on copies of the canned states with every available
+   * micro-architecture variant and report the throughput. */
+  template<typename KernelFunc>
+  void benchmark_integrator_kernel(const char *kernel_name,
+                                   const char *unit,
+                                   const DeviceKernel kernel,
+                                   const KernelFunc &get_kernel)
+  {
+    const vector<IntegratorStateCPU> canned_states = capture_states(kernel);
+    ASSERT_FALSE(canned_states.empty()) << "No states reached " << kernel_name;
+
+    const KernelGlobalsCPU *kg = &kernel_thread_globals[0];
+    float *render_buffer = render_buffers->buffer.data();
+    vector<IntegratorStateCPU> states(canned_states.size());
+
+    for (const KernelVariant &variant : KERNEL_VARIANTS) {
+      DebugFlags().cpu.sse2 = variant.sse2;
+      DebugFlags().cpu.sse41 = variant.sse41;
+      DebugFlags().cpu.avx2 = variant.avx2;
+
+      const CPUKernels kernels;
+      const auto &func = get_kernel(kernels);
+      if (strcmp(func.get_uarch_name(), variant.uarch_name) != 0) {
+        continue;
+      }
+
+      double time = 0.0;
+      uint64_t cycles = 0;
+      for (int iteration = 0; iteration < NUM_ITERATIONS; iteration++) {
+        memcpy(states.data(), canned_states.data(), sizeof(IntegratorStateCPU) * states.size());
+
+        const double start_time = time_dt();
+        const uint64_t start_cycles = cpu_cycles();
+        for (IntegratorStateCPU &state : states) {
+          func(kg, &state, render_buffer);
+        }
+        cycles += cpu_cycles() - start_cycles;
+        time += time_dt() - start_time;
+      }
+
+      print_result(
+          kernel_name, variant.uarch_name, unit, states.size() * NUM_ITERATIONS, time, cycles);
+    }
+  }
+};
+
+TEST_F(KernelCPUPerformance, intersect_closest)
+{
+  build_scene(false);
+  benchmark_integrator_kernel("integrator_intersect_closest",
+                              "rays",
+                              DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST,
+                              [](const CPUKernels &kernels) -> const auto & {
+                                return kernels.integrator_intersect_closest;
+                              });
+}
+
+TEST_F(KernelCPUPerformance, shade_surface)
+{
+  build_scene(false);
+  benchmark_integrator_kernel("integrator_shade_surface",
+                              "samples",
+                              DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE,
+                              [](const CPUKernels &kernels) -> const auto & {
+                                return kernels.integrator_shade_surface;
+                              });
+}
+
+TEST_F(KernelCPUPerformance, shade_volume)
+{
+  build_scene(true);
+  benchmark_integrator_kernel("integrator_shade_volume",
+                              "samples",
+                              DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME,
+                              [](const CPUKernels &kernels) -> const auto & {
+                                return kernels.integrator_shade_volume;
+                              });
+}
+
+TEST_F(KernelCPUPerformance, film_convert)
+{
+  build_scene(false);
+
+  /* Fill the render buffer with a sample of the actual render. */
+  capture_states(DEVICE_KERNEL_INTEGRATOR_NUM);
+
+  KernelFilmConvert kfilm_convert;
+  memset(&kfilm_convert, 0, sizeof(kfilm_convert));
+  kfilm_convert.pass_offset = buffer_params.get_pass_offset(PASS_COMBINED);
+  kfilm_convert.pass_stride = buffer_params.pass_stride;
+  kfilm_convert.pass_use_exposure = true;
+  kfilm_convert.pass_use_filter = true;
+  kfilm_convert.pass_divide = PASS_UNUSED;
+  kfilm_convert.pass_indirect = PASS_UNUSED;
+  kfilm_convert.pass_combined = buffer_params.get_pass_offset(PASS_COMBINED);
+  kfilm_convert.pass_sample_count = buffer_params.get_pass_offset(PASS_SAMPLE_COUNT);
+  kfilm_convert.pass_adaptive_aux_buffer = buffer_params.get_pass_offset(PASS_ADAPTIVE_AUX_BUFFER);
+  kfilm_convert.pass_motion_weight = buffer_params.get_pass_offset(PASS_MOTION_WEIGHT);
+  kfilm_convert.pass_shadow_catcher = PASS_UNUSED;
+  kfilm_convert.pass_shadow_catcher_sample_count = PASS_UNUSED;
+  kfilm_convert.pass_shadow_catcher_matte = PASS_UNUSED;
+  kfilm_convert.pass_background = buffer_params.get_pass_offset(PASS_BACKGROUND);
+  kfilm_convert.scale = 1.0f;
+  kfilm_convert.exposure = 1.0f;
+  kfilm_convert.scale_exposure = 1.0f;
+  kfilm_convert.num_components = 4;
+
+  const float *buffer = render_buffers->buffer.data();
+  const int64_t buffer_row_stride = (int64_t)buffer_params.stride * buffer_params.pass_stride;
+  vector<float> pixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+  vector<half4> pixels_half(IMAGE_SIZE * IMAGE_SIZE);
+
+  for (const KernelVariant &variant : KERNEL_VARIANTS) {
+    DebugFlags().cpu.sse2 = variant.sse2;
+    DebugFlags().cpu.sse41 = variant.sse41;
+    DebugFlags().cpu.avx2 = variant.avx2;
+
+    const CPUKernels kernels;
+    if (strcmp(kernels.film_convert_combined.get_uarch_name(), variant.uarch_name) != 0) {
+      continue;
+    }
+
+    double time = 0.0, time_half = 0.0;
+    uint64_t cycles = 0, cycles_half = 0;
+    for (int iteration = 0; iteration < NUM_ITERATIONS; iteration++) {
+      double start_time = time_dt();
+      uint64_t start_cycles = cpu_cycles();
+      for (int y = 0; y < IMAGE_SIZE; y++) {
+        kernels.film_convert_combined(&kfilm_convert,
+                                      buffer + y * buffer_row_stride,
+                                      pixels.data() + y * IMAGE_SIZE * 4,
+                                      IMAGE_SIZE,
+                                      buffer_params.pass_stride,
+                                      4);
+      }
+      cycles += cpu_cycles() - start_cycles;
+      time += time_dt() - start_time;
+
+      start_time = time_dt();
+      start_cycles = cpu_cycles();
+      for (int y = 0; y < IMAGE_SIZE; y++) {
+        kernels.film_convert_half_rgba_combined(&kfilm_convert,
+                                                buffer + y * buffer_row_stride,
+                                                pixels_half.data() + y * IMAGE_SIZE,
+                                                IMAGE_SIZE,
+                                                buffer_params.pass_stride);
+      }
+      cycles_half += cpu_cycles() - start_cycles;
+      time_half += time_dt() - start_time;
+    }
+
+    const size_t num_pixels = (size_t)IMAGE_SIZE * IMAGE_SIZE * NUM_ITERATIONS;
+    print_result("film_convert_combined", variant.uarch_name, "pixels", num_pixels, time, cycles);
+    print_result("film_convert_half_rgba_combined",
+                 variant.uarch_name,
+                 "pixels",
+                 num_pixels,
+                 time_half,
+                 cycles_half);
+  }
+}
+
+CCL_NAMESPACE_END
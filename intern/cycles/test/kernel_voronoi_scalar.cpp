@@ -0,0 +1,59 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "kernel_voronoi_scalar.h"
+
+#include "kernel/device/cpu/compat.h"
+#include "kernel/device/cpu/globals.h"
+
+#include "kernel/types.h"
+
+#include "kernel/svm/types.h"
+#include "kernel/svm/util.h"
+
+#include "util/hash.h"
+
+#include "kernel/svm/voronoi.h"
+
+CCL_NAMESPACE_BEGIN
+
+static VoronoiParams voronoi_params(const int metric, const float exponent, const float randomness)
+{
+  VoronoiParams params = {};
+  params.metric = NodeVoronoiDistanceMetric(metric);
+  params.exponent = exponent;
+  params.randomness = randomness;
+  return params;
+}
+
+VoronoiScalarOutput voronoi_3d_scalar(const int feature,
+                                      const int metric,
+                                      const float exponent,
+                                      const float randomness,
+                                      const float coord[3])
+{
+  const VoronoiParams params = voronoi_params(metric, exponent, randomness);
+  const float3 p = make_float3(coord[0], coord[1], coord[2]);
+  const VoronoiOutput octave = (feature == NODE_VORONOI_F2) ? voronoi_f2(params, p) :
+                                                              voronoi_f1(params, p);
+
+  VoronoiScalarOutput result;
+  result.distance = octave.distance;
+  for (int i = 0; i < 3; i++) {
+    result.color[i] = octave.color[i];
+    result.position[i] = octave.position[i];
+  }
+  return result;
+}
+
+float voronoi_3d_distance_scalar(const int metric,
+                                 const float exponent,
+                                 const float a[3],
+                                 const float b[3])
+{
+  const VoronoiParams params = voronoi_params(metric, exponent, 0.0f);
+  return voronoi_distance(make_float3(a[0], a[1], a[2]), make_float3(b[0], b[1], b[2]), params);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,25 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+CCL_NAMESPACE_BEGIN
+
+/* 3D Voronoi of the kernel compiled without __KERNEL_SSE__, to compare the SSE code path against.
+ * Vector types are defined differently with and without SSE, so only plain floats are passed. */
+
+struct VoronoiScalarOutput {
+  float distance;
+  float color[3];
+  float position[3];
+};
+
+/* Evaluate the F1 or F2 feature at the given coordinate. */
+VoronoiScalarOutput voronoi_3d_scalar(
+    int feature, int metric, float exponent, float randomness, const float coord[3]);
+
+/* Distance between two points with the given metric. */
+float voronoi_3d_distance_scalar(int metric, float exponent, const float a[3], const float b[3]);
+
+CCL_NAMESPACE_END
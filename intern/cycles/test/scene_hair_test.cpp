@@ -0,0 +1,165 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+
+#include "kernel/device/cpu/compat.h"
+#include "kernel/device/cpu/globals.h"
+
+#include "kernel/bvh/util.h"
+#include "kernel/geom/attribute.h"
+#include "kernel/geom/object.h"
+#include "kernel/geom/motion_curve.h"
+
+#include "scene/hair.h"
+#include "scene/scene.h"
+
+#include "util/stats.h"
+#include "util/vector.h"
+
+#include <random>
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+class HairCompactKeysTest : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  SceneParams scene_params;
+  Scene *scene;
+
+  virtual void SetUp()
+  {
+    device_cpu = Device::create(device_info, stats, profiler);
+    scene = new Scene(scene_params, device_cpu);
+  }
+
+  virtual void TearDown()
+  {
+    delete scene;
+    delete device_cpu;
+  }
+
+  /* Pack the curves compact, then decode every key with the kernel and check that the decoded
+   * key lies inside the original one. */
+  void expect_keys_decode_inside(Hair *hair)
+  {
+    hair->curve_key_offset = 0;
+    hair->prim_offset = 0;
+
+    const size_t num_keys = hair->num_keys();
+    const size_t num_curves = hair->num_curves();
+
+    vector<uint> curve_keys_compact(num_keys * 2);
+    vector<float4> curve_key_ranges(num_curves);
+    vector<KernelCurve> curves(num_curves);
+    vector<KernelCurveSegment> curve_segments(hair->num_segments());
+    hair->pack_curves(scene,
+                      nullptr,
+                      curve_keys_compact.data(),
+                      curve_key_ranges.data(),
+                      curves.data(),
+                      curve_segments.data());
+
+    KernelGlobalsCPU globals = {};
+    globals.data.bvh.use_compact_curves = true;
+    globals.curve_keys_compact.data = curve_keys_compact.data();
+    globals.curve_keys_compact.width = curve_keys_compact.size();
+    globals.curve_key_ranges.data = curve_key_ranges.data();
+    globals.curve_key_ranges.width = curve_key_ranges.size();
+    KernelGlobals kg = &globals;
+
+    for (size_t i = 0; i < num_curves; i++) {
+      const Hair::Curve curve = hair->get_curve(i);
+      const float4 range = curve_key_ranges[i];
+
+      for (int k = curve.first_key; k < curve.first_key + curve.num_keys; k++) {
+        const float3 co = hair->get_curve_keys()[k];
+        const float radius = hair->get_curve_radius()[k];
+        const float4 key = curve_key(kg, i, k);
+        const float distance = len(float4_to_float3(key) - co);
+        const float position_error = range.w * 0.5f * M_SQRT3_F;
+        const float tolerance = 1e-6f * max(reduce_max(fabs(co)), 1.0f);
+
+        /* Positions are rounded to the nearest step of the curve range. */
+        EXPECT_LE(distance, position_error + tolerance);
+
+        if (radius <= position_error) {
+          /* Nothing is left of the radius after shrinking it by the position error. */
+          EXPECT_EQ(key.w, 0.0f);
+        }
+        else {
+          /* The radius is shrunk by the position error, so that bounds computed from the
+           * original keys contain the decoded curve. */
+          EXPECT_GE(key.w, 0.0f);
+          EXPECT_LE(key.w + distance, radius + tolerance);
+        }
+      }
+    }
+  }
+};
+
+}  // namespace
+
+TEST_F(HairCompactKeysTest, RandomCurves)
+{
+  Hair *hair = scene->create_node<Hair>();
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+  std::uniform_real_distribution<float> radius(0.0f, 0.05f);
+
+  const int num_curves = 64;
+  const int num_curve_keys = 8;
+  hair->reserve_curves(num_curves, num_curves * num_curve_keys);
+
+  for (int i = 0; i < num_curves; i++) {
+    /* Curves of very different scales, away from the origin. */
+    const float scale = powf(10.0f, float(i % 5) - 2.0f);
+    const float3 origin = make_float3(offset(rng), offset(rng), offset(rng)) * 10.0f;
+
+    hair->add_curve(hair->num_keys(), 0);
+    for (int k = 0; k < num_curve_keys; k++) {
+      const float3 co = origin + make_float3(offset(rng), offset(rng), offset(rng)) * scale;
+      hair->add_curve_key(co, radius(rng) * scale);
+    }
+  }
+
+  expect_keys_decode_inside(hair);
+}
+
+TEST_F(HairCompactKeysTest, RadiusBelowPositionError)
+{
+  Hair *hair = scene->create_node<Hair>();
+  hair->reserve_curves(1, 3);
+
+  /* Range of 65535 gives a quantization step of 1, and a position error of 0.5 * sqrt(3). */
+  hair->add_curve(0, 0);
+  hair->add_curve_key(make_float3(0.0f, 0.0f, 0.0f), 0.8f);
+  hair->add_curve_key(make_float3(1234.3f, 40000.7f, 5.5f), 0.1f);
+  hair->add_curve_key(make_float3(65535.0f, 100.2f, 20000.4f), 2.0f);
+
+  expect_keys_decode_inside(hair);
+}
+
+TEST_F(HairCompactKeysTest, DegenerateCurve)
+{
+  Hair *hair = scene->create_node<Hair>();
+  hair->reserve_curves(1, 2);
+
+  /* All keys at the same location give an empty range, which must decode exactly. */
+  hair->add_curve(0, 0);
+  hair->add_curve_key(make_float3(1.0f, 2.0f, 3.0f), 0.5f);
+  hair->add_curve_key(make_float3(1.0f, 2.0f, 3.0f), 0.25f);
+
+  expect_keys_decode_inside(hair);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,219 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+
+#include "scene/colorspace.h"
+#include "scene/light.h"
+#include "scene/light_tree.h"
+#include "scene/mesh.h"
+#include "scene/object.h"
+#include "scene/scene.h"
+#include "scene/shader.h"
+
+#include "util/map.h"
+#include "util/progress.h"
+#include "util/stats.h"
+#include "util/transform.h"
+#include "util/unique_ptr.h"
+#include "util/vector.h"
+
+#include <tuple>
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+class LightTreeTest : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  SceneParams scene_params;
+  Scene *scene;
+  Progress progress;
+
+  virtual void SetUp()
+  {
+    ColorSpaceManager::init_fallback_config();
+
+    device_cpu = Device::create(device_info, stats, profiler);
+    scene = new Scene(scene_params, device_cpu);
+  }
+
+  virtual void TearDown()
+  {
+    delete scene;
+    delete device_cpu;
+  }
+
+  Mesh *add_emissive_quad_mesh(Shader *shader, const float size)
+  {
+    Mesh *mesh = scene->create_node<Mesh>();
+    array<Node *> used_shaders;
+    used_shaders.push_back_slow(shader);
+    mesh->set_used_shaders(used_shaders);
+
+    mesh->reserve_mesh(4, 2);
+    mesh->add_vertex(make_float3(0.0f, 0.0f, 0.0f));
+    mesh->add_vertex(make_float3(size, 0.0f, 0.0f));
+    mesh->add_vertex(make_float3(size, size, 0.0f));
+    mesh->add_vertex(make_float3(0.0f, size, 0.0f));
+    mesh->add_triangle(0, 1, 2, 0, false);
+    mesh->add_triangle(0, 2, 3, 0, false);
+    mesh->compute_bounds();
+
+    return mesh;
+  }
+
+  Object *add_object(Mesh *mesh, const float3 location)
+  {
+    Object *object = scene->create_node<Object>();
+    object->set_geometry(mesh);
+    object->set_tfm(transform_translate(location));
+    object->compute_bounds(false);
+    return object;
+  }
+
+  Light *add_light(const LightType type, const float3 location)
+  {
+    Light *light = scene->create_node<Light>();
+    light->set_light_type(type);
+    light->set_co(location);
+    light->set_dir(make_float3(0.0f, 0.0f, -1.0f));
+    light->set_strength(make_float3(10.0f, 10.0f, 10.0f));
+    light->set_size(0.1f);
+    light->set_angle(0.1f);
+    return light;
+  }
+
+  /* Build a light tree for the current state of the scene, like the light manager does. */
+  unique_ptr<LightTree> build_tree(LightTreeNode **root)
+  {
+    KernelIntegrator &kintegrator = scene->dscene.data.integrator;
+    kintegrator.num_lights = 0;
+    kintegrator.num_distant_lights = 0;
+    for (const Light *light : scene->lights) {
+      kintegrator.num_lights++;
+      if (light->get_light_type() == LIGHT_DISTANT) {
+        kintegrator.num_distant_lights++;
+      }
+    }
+
+    unique_ptr<LightTree> tree = make_unique<LightTree>(scene, &scene->dscene, progress, 1);
+    *root = tree->build(scene, &scene->dscene);
+    return tree;
+  }
+
+  vector<uint> object_lookup_offset()
+  {
+    const device_vector<uint> &offsets = scene->dscene.object_lookup_offset;
+    return vector<uint>(offsets.data(), offsets.data() + offsets.size());
+  }
+};
+
+/* Identify an emitter independently of its position in the tree: the kind of emitter followed by
+ * its object and primitive. */
+using EmitterKey = std::tuple<int, int, int>;
+
+map<EmitterKey, const LightTreeEmitter *> emitters_by_key(LightTree &tree)
+{
+  map<EmitterKey, const LightTreeEmitter *> emitters;
+  for (size_t i = 0; i < tree.num_emitters(); i++) {
+    const LightTreeEmitter &emitter = tree.get_emitters()[i];
+    EmitterKey key;
+    if (emitter.is_mesh()) {
+      key = EmitterKey(0, emitter.object_id, 0);
+    }
+    else if (emitter.is_light()) {
+      key = EmitterKey(1, emitter.object_id, emitter.light_id);
+    }
+    else {
+      key = EmitterKey(2, emitter.object_id, emitter.prim_id);
+    }
+    EXPECT_EQ(emitters.count(key), 0);
+    emitters[key] = &emitter;
+  }
+  return emitters;
+}
+
+void expect_float3_near(const float3 a, const float3 b, const float tolerance)
+{
+  EXPECT_NEAR(a.x, b.x, tolerance);
+  EXPECT_NEAR(a.y, b.y, tolerance);
+  EXPECT_NEAR(a.z, b.z, tolerance);
+}
+
+void expect_measure_near(const LightTreeMeasure &a, const LightTreeMeasure &b)
+{
+  expect_float3_near(a.bbox.min, b.bbox.min, 1e-5f);
+  expect_float3_near(a.bbox.max, b.bbox.max, 1e-5f);
+  EXPECT_NEAR(a.energy, b.energy, 1e-5f * fmaxf(a.energy, 1.0f));
+}
+
+}  // namespace
+
+/* Refitting after moving lights and objects gives the same emitters as building a new tree, with
+ * lamps and mesh lights mixed in the leaves of the tree. */
+TEST_F(LightTreeTest, RefitMatchesBuild)
+{
+  Shader *shader = scene->create_node<Shader>();
+  shader->emission_sampling = EMISSION_SAMPLING_FRONT_BACK;
+  shader->emission_estimate = make_float3(1.0f, 1.0f, 1.0f);
+
+  Mesh *mesh_a = add_emissive_quad_mesh(shader, 1.0f);
+  Mesh *mesh_b = add_emissive_quad_mesh(shader, 0.5f);
+
+  /* Interleave lamps and instanced mesh lights in space, so that they share subtrees. */
+  vector<Object *> objects;
+  vector<Light *> lights;
+  for (int i = 0; i < 6; i++) {
+    objects.push_back(add_object((i % 2) ? mesh_b : mesh_a, make_float3(i * 2.0f, 0.0f, 0.0f)));
+    lights.push_back(add_light(LIGHT_POINT, make_float3(i * 2.0f + 1.0f, 0.5f, 0.0f)));
+  }
+  lights.push_back(add_light(LIGHT_SPOT, make_float3(3.0f, 3.0f, 1.0f)));
+  lights.push_back(add_light(LIGHT_DISTANT, zero_float3()));
+
+  LightTreeNode *refit_root = nullptr;
+  unique_ptr<LightTree> refit_tree = build_tree(&refit_root);
+  ASSERT_NE(refit_root, nullptr);
+  ASSERT_TRUE(refit_tree->can_refit(scene));
+
+  lights[2]->set_co(make_float3(-4.0f, 2.0f, 1.0f));
+  lights[3]->set_strength(make_float3(50.0f, 50.0f, 50.0f));
+  objects[1]->set_tfm(transform_translate(make_float3(3.0f, -5.0f, 2.0f)));
+  objects[1]->compute_bounds(false);
+  objects[4]->set_tfm(transform_translate(make_float3(0.0f, 0.0f, 6.0f)) *
+                      transform_rotate(M_PI_2_F, make_float3(1.0f, 0.0f, 0.0f)));
+  objects[4]->compute_bounds(false);
+
+  ASSERT_TRUE(refit_tree->can_refit(scene));
+  EXPECT_EQ(refit_tree->refit(scene, &scene->dscene), refit_root);
+  const vector<uint> refit_offsets = object_lookup_offset();
+
+  LightTreeNode *build_root = nullptr;
+  unique_ptr<LightTree> build_tree_after = build_tree(&build_root);
+  ASSERT_NE(build_root, nullptr);
+  EXPECT_EQ(refit_offsets, object_lookup_offset());
+
+  const map<EmitterKey, const LightTreeEmitter *> refit_emitters = emitters_by_key(*refit_tree);
+  const map<EmitterKey, const LightTreeEmitter *> build_emitters = emitters_by_key(
+      *build_tree_after);
+  ASSERT_EQ(refit_emitters.size(), build_emitters.size());
+
+  for (const auto &[key, refit_emitter] : refit_emitters) {
+    const auto build_it = build_emitters.find(key);
+    ASSERT_TRUE(build_it != build_emitters.end());
+    const LightTreeEmitter *build_emitter = build_it->second;
+    expect_float3_near(refit_emitter->centroid, build_emitter->centroid, 1e-5f);
+    expect_measure_near(refit_emitter->measure, build_emitter->measure);
+  }
+
+  expect_measure_near(refit_root->measure, build_root->measure);
+}
+
+CCL_NAMESPACE_END
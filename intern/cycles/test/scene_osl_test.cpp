@@ -0,0 +1,102 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "device/device.h"
+
+#include "scene/osl.h"
+
+#include "util/stats.h"
+#include "util/unique_ptr.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+/* Shader with a single float parameter, compiled by oslc from:
+ *
+ *   shader cache_test(float value = 0.5, output float result = 0.0)
+ *   {
+ *     result = value;
+ *   }
+ */
+const char *cache_test_oso =
+    "OpenShadingLanguage 1.00\n"
+    "# Compiled by oslc\n"
+    "shader cache_test\n"
+    "param\tfloat\tvalue\t0.5\n"
+    "oparam\tfloat\tresult\t0\n"
+    "code ___main___\n"
+    "\tassign\tresult value\n"
+    "\tend\n";
+
+class OSLShaderGroupCacheTest : public testing::Test {
+ protected:
+  Stats stats;
+  Profiler profiler;
+  DeviceInfo device_info;
+  Device *device_cpu;
+  unique_ptr<OSLShaderManager> manager;
+  OSL::ErrorHandler errhandler;
+  unique_ptr<OSL::ShadingSystem> ss;
+
+  virtual void SetUp()
+  {
+    device_cpu = Device::create(device_info, stats, profiler);
+    manager = make_unique<OSLShaderManager>(device_cpu);
+
+    ss = make_unique<OSL::ShadingSystem>(nullptr, nullptr, &errhandler);
+    ASSERT_TRUE(ss->LoadMemoryCompiledShader("cache_test", cache_test_oso));
+  }
+
+  virtual void TearDown()
+  {
+    manager.reset();
+    /* Release cached groups before the shading system that created them. */
+    OSLShaderManager::free_memory();
+    ss.reset();
+    delete device_cpu;
+  }
+
+  OSL::ShaderGroupRef create_group(const string &name, const float value)
+  {
+    OSL::ShaderGroupRef group = ss->ShaderGroupBegin(name);
+    ss->Parameter("value", TypeDesc::TypeFloat, &value);
+    ss->Shader("surface", "cache_test", "layer");
+    ss->ShaderGroupEnd();
+    return group;
+  }
+};
+
+}  // namespace
+
+TEST_F(OSLShaderGroupCacheTest, HitAndMiss)
+{
+  /* The first group is added to the cache. */
+  OSL::ShaderGroupRef group_a = create_group("group_a", 0.5f);
+  EXPECT_EQ(manager->shader_group_cached(ss.get(), group_a), group_a);
+  EXPECT_EQ(manager->get_group_cache_hits(), 0);
+  EXPECT_EQ(manager->get_group_cache_misses(), 1);
+
+  /* An identical group, as created by the next render, reuses the cached one. */
+  OSL::ShaderGroupRef group_a_again = create_group("group_a", 0.5f);
+  EXPECT_EQ(manager->shader_group_cached(ss.get(), group_a_again), group_a);
+  EXPECT_EQ(manager->get_group_cache_hits(), 1);
+  EXPECT_EQ(manager->get_group_cache_misses(), 1);
+
+  /* A different parameter value gives a different group. */
+  OSL::ShaderGroupRef group_b = create_group("group_a", 0.25f);
+  EXPECT_EQ(manager->shader_group_cached(ss.get(), group_b), group_b);
+  EXPECT_EQ(manager->get_group_cache_hits(), 1);
+  EXPECT_EQ(manager->get_group_cache_misses(), 2);
+
+  /* The cache outlives the shader manager, as it does between renders. */
+  manager = make_unique<OSLShaderManager>(device_cpu);
+  EXPECT_EQ(manager->shader_group_cached(ss.get(), create_group("group_a", 0.25f)), group_b);
+  EXPECT_EQ(manager->get_group_cache_hits(), 1);
+  EXPECT_EQ(manager->get_group_cache_misses(), 0);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,217 @@
+/* SPDX-FileCopyrightText: 2011-2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#define __KERNEL_SSE__
+#define __KERNEL_SSE2__
+
+#include "testing/testing.h"
+
+#include "kernel/device/cpu/compat.h"
+#include "kernel/device/cpu/globals.h"
+
+#include "kernel/types.h"
+
+#include "kernel/svm/types.h"
+#include "kernel/svm/util.h"
+
+#include "util/hash.h"
+#include "util/system.h"
+
+#include "kernel/svm/voronoi.h"
+
+#include "kernel_voronoi_scalar.h"
+
+#include <algorithm>
+#include <random>
+
+CCL_NAMESPACE_BEGIN
+
+#if (defined(i386) || defined(_M_IX86) || defined(__x86_64__) || defined(_M_X64)) && \
+    defined(__SSE2__)
+
+TEST(util_hash_sse, uint4_to_float4_incl)
+{
+  if (!system_cpu_support_sse2()) {
+    return;
+  }
+
+  const uint values[] = {0u, 1u, 0xFFFFu, 0x10000u, 0x12345678u, 0x7FFFFFFFu, 0x80000001u,
+                         0xFFFFFF7Fu, 0xFFFFFF80u, 0xFFFFFFFFu};
+
+  for (const uint value : values) {
+    const float4 result = uint4_to_float4_incl(make_int4(int(value)));
+    EXPECT_EQ(result[0], uint_to_float_incl(value));
+  }
+}
+
+TEST(util_hash_sse, hash_float4_3_to_float4_3)
+{
+  if (!system_cpu_support_sse2()) {
+    return;
+  }
+
+  const float4 x = make_float4(-2.0f, 0.0f, 1.0f, 123.5f);
+  const float4 y = make_float4(3.0f, -7.0f, 0.25f, -1e6f);
+  const float4 z = make_float4(0.0f, 5.0f, -0.0f, 42.0f);
+
+  float4 rx, ry, rz;
+  hash_float4_3_to_float4_3(x, y, z, &rx, &ry, &rz);
+
+  for (int i = 0; i < 4; i++) {
+    const float3 expected = hash_float3_to_float3(make_float3(x[i], y[i], z[i]));
+    EXPECT_EQ(rx[i], expected.x);
+    EXPECT_EQ(ry[i], expected.y);
+    EXPECT_EQ(rz[i], expected.z);
+  }
+}
+
+namespace {
+
+const NodeVoronoiDistanceMetric voronoi_metrics[] = {NODE_VORONOI_EUCLIDEAN,
+                                                     NODE_VORONOI_MANHATTAN,
+                                                     NODE_VORONOI_CHEBYCHEV,
+                                                     NODE_VORONOI_MINKOWSKI};
+
+/* The SSE code sums the components of the distances in a different order than the scalar code,
+ * so distances only match up to rounding. */
+float voronoi_tolerance(const float distance)
+{
+  return 1e-5f * max(distance, 1.0f);
+}
+
+float voronoi_distance_scalar(const VoronoiParams &params, const float3 a, const float3 b)
+{
+  const float a_[3] = {a.x, a.y, a.z};
+  const float b_[3] = {b.x, b.y, b.z};
+  return voronoi_3d_distance_scalar(params.metric, params.exponent, a_, b_);
+}
+
+/* Whether the scalar distance of the cell picked for the given rank is so close to the one of
+ * another cell, that rounding differences may pick the other cell instead. */
+bool voronoi_has_near_tie(const VoronoiParams &params,
+                          const float3 coord,
+                          const int rank,
+                          const float tolerance)
+{
+  const float3 cellPosition = floor(coord);
+  const float3 localPosition = coord - cellPosition;
+
+  float distances[27];
+  int n = 0;
+  for (int k = -1; k <= 1; k++) {
+    for (int j = -1; j <= 1; j++) {
+      for (int i = -1; i <= 1; i++) {
+        const float3 cellOffset = make_float3(i, j, k);
+        const float3 pointPosition = cellOffset + hash_float3_to_float3(cellPosition +
+                                                                        cellOffset) *
+                                                      params.randomness;
+        distances[n++] = voronoi_distance_scalar(params, pointPosition, localPosition);
+      }
+    }
+  }
+  std::sort(distances, distances + n);
+
+  return (distances[rank + 1] - distances[rank] <= 2.0f * tolerance) ||
+         (rank > 0 && distances[rank] - distances[rank - 1] <= 2.0f * tolerance);
+}
+
+}  // namespace
+
+TEST(util_hash_sse, voronoi_row_distances)
+{
+  if (!system_cpu_support_sse2()) {
+    return;
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> randomness(0.0f, 1.0f);
+  std::uniform_real_distribution<float> exponent(0.5f, 4.0f);
+
+  for (const NodeVoronoiDistanceMetric metric : voronoi_metrics) {
+    for (int n = 0; n < 100; n++) {
+      VoronoiParams params = {};
+      params.metric = metric;
+      params.exponent = exponent(rng);
+      params.randomness = randomness(rng);
+
+      const float3 p = make_float3(coord(rng), coord(rng), coord(rng));
+      const float3 cellPosition = floor(p);
+      const float3 localPosition = p - cellPosition;
+
+      for (int k = -1; k <= 1; k++) {
+        for (int j = -1; j <= 1; j++) {
+          float4 pointX, pointY, pointZ;
+          const float4 distances = voronoi_row_distances(
+              params, cellPosition, localPosition, j, k, &pointX, &pointY, &pointZ);
+
+          for (int i = -1; i <= 1; i++) {
+            const float3 cellOffset = make_float3(i, j, k);
+            const float3 expected = cellOffset + hash_float3_to_float3(cellPosition +
+                                                                       cellOffset) *
+                                                     params.randomness;
+            EXPECT_FLOAT_EQ(pointX[i + 1], expected.x);
+            EXPECT_FLOAT_EQ(pointY[i + 1], expected.y);
+            EXPECT_FLOAT_EQ(pointZ[i + 1], expected.z);
+
+            const float expected_distance = voronoi_distance_scalar(
+                params, expected, localPosition);
+            EXPECT_NEAR(
+                distances[i + 1], expected_distance, voronoi_tolerance(expected_distance));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(util_hash_sse, voronoi_f1_f2)
+{
+  if (!system_cpu_support_sse2()) {
+    return;
+  }
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> randomness(0.0f, 1.0f);
+  std::uniform_real_distribution<float> exponent(0.5f, 4.0f);
+
+  for (const NodeVoronoiFeature feature : {NODE_VORONOI_F1, NODE_VORONOI_F2}) {
+    for (const NodeVoronoiDistanceMetric metric : voronoi_metrics) {
+      for (int n = 0; n < 1000; n++) {
+        VoronoiParams params = {};
+        params.feature = feature;
+        params.metric = metric;
+        params.exponent = exponent(rng);
+        params.randomness = randomness(rng);
+
+        const float coord_[3] = {coord(rng), coord(rng), coord(rng)};
+        const float3 p = make_float3(coord_[0], coord_[1], coord_[2]);
+
+        const VoronoiOutput octave = (feature == NODE_VORONOI_F2) ? voronoi_f2(params, p) :
+                                                                    voronoi_f1(params, p);
+        const VoronoiScalarOutput expected = voronoi_3d_scalar(
+            feature, metric, params.exponent, params.randomness, coord_);
+
+        const float tolerance = voronoi_tolerance(expected.distance);
+        EXPECT_NEAR(octave.distance, expected.distance, tolerance);
+
+        /* With almost equal distances, either cell is a valid result. */
+        const int rank = (feature == NODE_VORONOI_F2) ? 1 : 0;
+        if (voronoi_has_near_tie(params, p, rank, tolerance)) {
+          continue;
+        }
+
+        for (int i = 0; i < 3; i++) {
+          EXPECT_EQ(octave.color[i], expected.color[i]);
+          EXPECT_FLOAT_EQ(octave.position[i], expected.position[i]);
+        }
+      }
+    }
+  }
+}
+
+#endif
+
+CCL_NAMESPACE_END
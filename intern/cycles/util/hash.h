@@ -318,6 +318,33 @@ ccl_device_inline int4 hash_int4_4(int4 kx, int4 ky, int4 kz, int4 kw)
   return c;
 }
 
+/* SSE version of uint_to_float_incl(). There is no unsigned integer conversion, so the upper and
+ * lower 16 bits are converted separately. Both halves are exact, so the sum is only rounded once
+ * and matches the scalar conversion. */
+ccl_device_inline float4 uint4_to_float4_incl(const int4 n)
+{
+  const float4 f = make_float4(srl(n, 16)) * 65536.0f + make_float4(n & 0xFFFF);
+  return f * (1.0f / (float)0xFFFFFFFFu);
+}
+
+/* SSE version of hash_float3_to_float3() for four points, given and returned as separate
+ * x, y and z components. */
+ccl_device_inline void hash_float4_3_to_float4_3(const float4 kx,
+                                                 const float4 ky,
+                                                 const float4 kz,
+                                                 ccl_private float4 *rx,
+                                                 ccl_private float4 *ry,
+                                                 ccl_private float4 *rz)
+{
+  const int4 x = cast(kx);
+  const int4 y = cast(ky);
+  const int4 z = cast(kz);
+
+  *rx = uint4_to_float4_incl(hash_int4_3(x, y, z));
+  *ry = uint4_to_float4_incl(hash_int4_4(x, y, z, make_int4(__float_as_int(1.0f))));
+  *rz = uint4_to_float4_incl(hash_int4_4(x, y, z, make_int4(__float_as_int(2.0f))));
+}
+
 #  if defined(__KERNEL_AVX2__)
 ccl_device_inline vint8 hash_int8(vint8 kx)
 {
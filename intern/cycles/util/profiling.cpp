@@ -26,6 +26,7 @@ void Profiler::run()
       uint32_t cur_event = state->event;
       int32_t cur_shader = state->shader;
       int32_t cur_object = state->object;
+      int32_t cur_svm_node = state->svm_node;
 
       /* The state reads/writes should be atomic, but just to be sure
        * check the values for validity anyways. */
@@ -40,6 +41,14 @@ void Profiler::run()
       if (cur_object >= 0 && cur_object < object_samples.size()) {
         object_samples[cur_object]++;
       }
+
+      if (cur_svm_node >= 0 && cur_svm_node < num_svm_nodes) {
+        svm_node_samples[cur_svm_node]++;
+
+        if (cur_shader >= 0 && cur_shader < shader_samples.size()) {
+          shader_svm_node_samples[cur_shader * num_svm_nodes + cur_svm_node]++;
+        }
+      }
     }
     lock.unlock();
 
@@ -52,7 +61,7 @@ void Profiler::run()
   }
 }
 
-void Profiler::reset(int num_shaders, int num_objects)
+void Profiler::reset(int num_shaders, int num_objects, int num_svm_nodes, int num_images)
 {
   bool running = (worker != NULL);
   if (running) {
@@ -67,6 +76,13 @@ void Profiler::reset(int num_shaders, int num_objects)
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
 
+  this->num_svm_nodes = num_svm_nodes;
+  svm_node_hits.assign(num_svm_nodes, 0);
+  svm_node_samples.assign(num_svm_nodes, 0);
+  shader_svm_node_samples.assign(size_t(num_shaders) * num_svm_nodes, 0);
+
+  image_bytes.assign(num_images, 0);
+
   if (running) {
     start();
   }
@@ -101,11 +117,14 @@ void Profiler::add_state(ProfilingState *state)
   /* Resize thread-local hit counters. */
   state->shader_hits.assign(shader_hits.size(), 0);
   state->object_hits.assign(object_hits.size(), 0);
+  state->svm_node_hits.assign(svm_node_hits.size(), 0);
+  state->image_bytes.assign(image_bytes.size(), 0);
 
   /* Initialize the state. */
   state->event = PROFILING_UNKNOWN;
   state->shader = -1;
   state->object = -1;
+  state->svm_node = -1;
   state->active = true;
 }
 
@@ -127,6 +146,16 @@ void Profiler::remove_state(ProfilingState *state)
   for (int i = 0; i < object_hits.size(); i++) {
     object_hits[i] += state->object_hits[i];
   }
+
+  assert(svm_node_hits.size() == state->svm_node_hits.size());
+  for (int i = 0; i < svm_node_hits.size(); i++) {
+    svm_node_hits[i] += state->svm_node_hits[i];
+  }
+
+  assert(image_bytes.size() == state->image_bytes.size());
+  for (int i = 0; i < image_bytes.size(); i++) {
+    image_bytes[i] += state->image_bytes[i];
+  }
 }
 
 uint64_t Profiler::get_event(ProfilingEvent event)
@@ -157,6 +186,35 @@ bool Profiler::get_object(int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+bool Profiler::get_svm_node(int node, uint64_t &samples, uint64_t &hits)
+{
+  assert(worker == NULL);
+  if (node >= num_svm_nodes || svm_node_samples[node] == 0) {
+    return false;
+  }
+  samples = svm_node_samples[node];
+  hits = svm_node_hits[node];
+  return true;
+}
+
+uint64_t Profiler::get_shader_svm_node(int shader, int node)
+{
+  assert(worker == NULL);
+  if (node >= num_svm_nodes) {
+    return 0;
+  }
+  return shader_svm_node_samples[size_t(shader) * num_svm_nodes + node];
+}
+
+uint64_t Profiler::get_image_bytes(int image)
+{
+  assert(worker == NULL);
+  if (image >= image_bytes.size()) {
+    return 0;
+  }
+  return image_bytes[image];
+}
+
 bool Profiler::active() const
 {
   return (worker != nullptr);
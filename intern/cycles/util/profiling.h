@@ -63,10 +63,22 @@ struct ProfilingState {
   volatile uint32_t event = PROFILING_UNKNOWN;
   volatile int32_t shader = -1;
   volatile int32_t object = -1;
+  volatile int32_t svm_node = -1;
   volatile bool active = false;
 
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+  vector<uint64_t> svm_node_hits;
+
+  /* Number of bytes fetched from every image texture, indexed by the image slot. */
+  vector<uint64_t> image_bytes;
+
+  inline void add_image_fetch(int image, uint64_t bytes)
+  {
+    if (image >= 0 && image < image_bytes.size()) {
+      image_bytes[image] += bytes;
+    }
+  }
 };
 
 class Profiler {
@@ -74,7 +86,7 @@ class Profiler {
   Profiler();
   ~Profiler();
 
-  void reset(int num_shaders, int num_objects);
+  void reset(int num_shaders, int num_objects, int num_svm_nodes, int num_images);
 
   void start();
   void stop();
@@ -85,6 +97,9 @@ class Profiler {
   uint64_t get_event(ProfilingEvent event);
   bool get_shader(int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(int object, uint64_t &samples, uint64_t &hits);
+  bool get_svm_node(int node, uint64_t &samples, uint64_t &hits);
+  uint64_t get_shader_svm_node(int shader, int node);
+  uint64_t get_image_bytes(int image);
 
   bool active() const;
 
@@ -105,6 +120,17 @@ class Profiler {
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
 
+  /* Same as above, but for the SVM node types.
+   * The per-shader samples are stored as a matrix indexed by shader and node type, which allows
+   * to see which nodes make a specific material slow. */
+  vector<uint64_t> svm_node_samples;
+  vector<uint64_t> shader_svm_node_samples;
+  vector<uint64_t> svm_node_hits;
+  int num_svm_nodes = 0;
+
+  /* Total amount of bytes fetched from every image, indexed by the image slot. */
+  vector<uint64_t> image_bytes;
+
   volatile bool do_stop_worker;
   thread *worker;
 
@@ -167,6 +193,29 @@ class ProfilingWithShaderHelper : public ProfilingHelper {
   }
 };
 
+class ProfilingWithSVMNodeHelper {
+ public:
+  ProfilingWithSVMNodeHelper(ProfilingState *state) : state(state) {}
+
+  ~ProfilingWithSVMNodeHelper()
+  {
+    state->svm_node = -1;
+  }
+
+  inline void set_svm_node(int node)
+  {
+    state->svm_node = node;
+
+    if (state->active) {
+      assert(node < state->svm_node_hits.size());
+      state->svm_node_hits[node]++;
+    }
+  }
+
+ protected:
+  ProfilingState *state;
+};
+
 CCL_NAMESPACE_END
 
 #endif /* __UTIL_PROFILING_H__ */
@@ -167,6 +167,13 @@ extern size_t (*MEM_get_memory_in_use)(void);
 /** Get amount of memory blocks in use. */
 extern unsigned int (*MEM_get_memory_blocks_in_use)(void);
 
+/**
+ * Memory allocated minus memory freed by the calling thread, in bytes. Can be negative when the
+ * thread frees memory allocated by others, only differences between two calls are meaningful.
+ * Not tracked by the guarded allocator, which always returns zero.
+ */
+extern int64_t (*MEM_get_thread_memory_in_use)(void);
+
 /** Reset the peak memory statistic to zero. */
 extern void (*MEM_reset_peak_memory)(void);
 
@@ -46,6 +46,7 @@ bool (*MEM_consistency_check)(void) = MEM_lockfree_consistency_check;
 void (*MEM_set_memory_debug)(void) = MEM_lockfree_set_memory_debug;
 size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 uint (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
+int64_t (*MEM_get_thread_memory_in_use)(void) = MEM_lockfree_get_thread_memory_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
 
@@ -126,6 +127,7 @@ void MEM_use_lockfree_allocator(void)
   MEM_set_memory_debug = MEM_lockfree_set_memory_debug;
   MEM_get_memory_in_use = MEM_lockfree_get_memory_in_use;
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
+  MEM_get_thread_memory_in_use = MEM_lockfree_get_thread_memory_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
 
@@ -158,6 +160,7 @@ void MEM_use_guarded_allocator(void)
   MEM_set_memory_debug = MEM_guarded_set_memory_debug;
   MEM_get_memory_in_use = MEM_guarded_get_memory_in_use;
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
+  MEM_get_thread_memory_in_use = MEM_guarded_get_thread_memory_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
 
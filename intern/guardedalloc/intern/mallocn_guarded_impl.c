@@ -1192,6 +1192,12 @@ uint MEM_guarded_get_memory_blocks_in_use(void)
   return _totblock;
 }
 
+int64_t MEM_guarded_get_thread_memory_in_use(void)
+{
+  /* Memory usage is only tracked globally. */
+  return 0;
+}
+
 #ifndef NDEBUG
 const char *MEM_guarded_name_ptr(void *vmemh)
 {
@@ -100,6 +100,7 @@ void memory_usage_block_alloc(size_t size);
 void memory_usage_block_free(size_t size);
 size_t memory_usage_block_num(void);
 size_t memory_usage_current(void);
+int64_t memory_usage_thread_current(void);
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
 
@@ -140,6 +141,7 @@ bool MEM_lockfree_consistency_check(void);
 void MEM_lockfree_set_memory_debug(void);
 size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
+int64_t MEM_lockfree_get_thread_memory_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
 size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
 #ifndef NDEBUG
@@ -184,6 +186,7 @@ bool MEM_guarded_consistency_check(void);
 void MEM_guarded_set_memory_debug(void);
 size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
+int64_t MEM_guarded_get_thread_memory_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
 size_t MEM_guarded_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
 #ifndef NDEBUG
@@ -383,6 +383,11 @@ uint MEM_lockfree_get_memory_blocks_in_use(void)
   return (uint)memory_usage_block_num();
 }
 
+int64_t MEM_lockfree_get_thread_memory_in_use(void)
+{
+  return memory_usage_thread_current();
+}
+
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
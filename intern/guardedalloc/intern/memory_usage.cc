@@ -252,6 +252,14 @@ size_t memory_usage_current()
   return size_t(mem_in_use);
 }
 
+int64_t memory_usage_thread_current()
+{
+  if (!use_local_counters) {
+    return 0;
+  }
+  return get_local_data().mem_in_use;
+}
+
 /**
  * Get the approximate peak memory usage since the last call to #memory_usage_peak_reset.
  * This is approximate, because the peak usage is not updated after every allocation (see
@@ -8,6 +8,8 @@
  * \ingroup bke
  */
 
+#include "BLI_index_mask.hh"
+
 #include "BKE_mesh.h"
 
 namespace blender::bke::mesh {
@@ -205,6 +207,19 @@ void edges_sharp_from_angle_set(OffsetIndices<int> polys,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Cache Tagging
+ * \{ */
+
+/**
+ * Call after changing the positions of only some vertices, instead of
+ * #BKE_mesh_tag_positions_changed. Normals which were calculated before are then only updated
+ * around the moved vertices the next time they are needed.
+ */
+void tag_positions_changed_partial(Mesh &mesh, const IndexMask &changed_verts);
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Topology Queries
  * \{ */
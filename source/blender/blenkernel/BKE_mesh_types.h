@@ -85,6 +85,14 @@ struct LooseEdgeCache : public LooseGeomCache {
 struct LooseVertCache : public LooseGeomCache {
 };
 
+/**
+ * Cache of the faces using every vertex, in the layout of #GroupedSpan.
+ */
+struct VertToPolyMapCache {
+  Array<int> offsets;
+  Array<int> indices;
+};
+
 struct MeshRuntime {
   /* Evaluated mesh for objects which do not have effective modifiers.
    * This mesh is used as a result of modifier stack evaluation.
@@ -168,6 +176,18 @@ struct MeshRuntime {
   bool poly_normals_dirty = true;
   mutable Vector<float3> vert_normals;
   mutable Vector<float3> poly_normals;
+  /**
+   * Vertices which moved since the normals above were valid, when only some of them did (see
+   * #bke::mesh::tag_positions_changed_partial). When not empty, the dirty normals are only
+   * updated around these vertices instead of being recomputed for the whole mesh. A vertex may
+   * be contained more than once.
+   */
+  Vector<int> normals_dirty_verts;
+  /**
+   * Faces around every vertex, used to find the normals to update around moved vertices. Only
+   * built for partial normal updates, it is reused as long as the topology does not change.
+   */
+  SharedCache<VertToPolyMapCache> vert_to_poly_map_cache;
 
   /** Cache of data about edges not used by faces. See #Mesh::loose_edges(). */
   SharedCache<LooseEdgeCache> loose_edges_cache;
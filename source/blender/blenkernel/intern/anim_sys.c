@@ -407,6 +407,37 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   return true;
 }
 
+/**
+ * Same as #BKE_animsys_rna_path_resolve, but re-uses the result of the previous call when the
+ * F-Curve has the same RNA path, only updating the array index. F-Curves animating the elements
+ * of an array property (`location[0..2]`, ...) are stored next to each other, and resolving the
+ * path is the most expensive part of evaluating them (look-up of bones by name, ...).
+ *
+ * \param prev_rna_path: Path of the previous successful call, or NULL when there is none yet.
+ * \param r_result: Must be the result of the previous call.
+ */
+static bool animsys_rna_path_resolve_reuse(PointerRNA *ptr,
+                                           const FCurve *fcu,
+                                           const char **prev_rna_path,
+                                           PathResolvedRNA *r_result)
+{
+  if (*prev_rna_path != NULL && fcu->rna_path != NULL && STREQ(*prev_rna_path, fcu->rna_path)) {
+    const int array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+    if (array_len && fcu->array_index >= array_len) {
+      return false;
+    }
+    r_result->prop_index = array_len ? fcu->array_index : -1;
+    return true;
+  }
+
+  if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, r_result)) {
+    *prev_rna_path = NULL;
+    return false;
+  }
+  *prev_rna_path = fcu->rna_path;
+  return true;
+}
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -587,6 +618,9 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  PathResolvedRNA anim_rna;
+  const char *resolved_rna_path = NULL;
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -594,8 +628,7 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
       continue;
     }
 
-    PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_reuse(ptr, fcu, &resolved_rna_path, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
@@ -868,12 +901,14 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     return;
   }
 
+  PathResolvedRNA anim_rna;
+  const char *resolved_rna_path = NULL;
+
   /* calculate then execute each curve */
   for (fcu = agrp->channels.first; (fcu) && (fcu->grp == agrp); fcu = fcu->next) {
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
-      PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_reuse(ptr, fcu, &resolved_rna_path, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
@@ -1165,11 +1200,22 @@ static bool nlaevalchan_keycmp(const void *a, const void *b)
 
 /* ---------------------- */
 
-/* Allocate a new blending value snapshot for the channel. */
+/* Allocate a new blending value snapshot for the channel, or reuse an unused one. */
 static NlaEvalChannelSnapshot *nlaevalchan_snapshot_new(NlaEvalChannel *nec)
 {
   int length = nec->base_snapshot.length;
 
+  if (nec->free_snapshots != NULL) {
+    NlaEvalChannelSnapshot *nec_snapshot = nec->free_snapshots;
+    nec->free_snapshots = nec_snapshot->next_free;
+    nec_snapshot->next_free = NULL;
+
+    BLI_bitmap_set_all(nec_snapshot->blend_domain.ptr, false, length);
+    BLI_bitmap_set_all(nec_snapshot->remap_domain.ptr, false, length);
+    memset(nec_snapshot->values, 0, sizeof(float) * length);
+    return nec_snapshot;
+  }
+
   size_t byte_size = sizeof(NlaEvalChannelSnapshot) + sizeof(float) * length;
   NlaEvalChannelSnapshot *nec_snapshot = MEM_callocN(byte_size, "NlaEvalChannelSnapshot");
 
@@ -1181,6 +1227,18 @@ static NlaEvalChannelSnapshot *nlaevalchan_snapshot_new(NlaEvalChannel *nec)
   return nec_snapshot;
 }
 
+/* Return a channel's blending value snapshot to the pool of the channel.
+ * Layered and transition strips create and release snapshots of the same channels for every
+ * strip, this avoids allocating them over and over. */
+static void nlaevalchan_snapshot_release(NlaEvalChannelSnapshot *nec_snapshot)
+{
+  BLI_assert(!nec_snapshot->is_base);
+
+  NlaEvalChannel *nec = nec_snapshot->channel;
+  nec_snapshot->next_free = nec->free_snapshots;
+  nec->free_snapshots = nec_snapshot;
+}
+
 /* Free a channel's blending value snapshot. */
 static void nlaevalchan_snapshot_free(NlaEvalChannelSnapshot *nec_snapshot)
 {
@@ -1284,7 +1342,7 @@ static void nlaeval_snapshot_free_data(NlaEvalSnapshot *snapshot)
     for (int i = 0; i < snapshot->size; i++) {
       NlaEvalChannelSnapshot *nec_snapshot = snapshot->channels[i];
       if (nec_snapshot != NULL) {
-        nlaevalchan_snapshot_free(nec_snapshot);
+        nlaevalchan_snapshot_release(nec_snapshot);
       }
     }
 
@@ -1302,6 +1360,12 @@ static void nlaeval_snapshot_free_data(NlaEvalSnapshot *snapshot)
 static void nlaevalchan_free_data(NlaEvalChannel *nec)
 {
   nlavalidmask_free(&nec->domain);
+
+  while (nec->free_snapshots != NULL) {
+    NlaEvalChannelSnapshot *nec_snapshot = nec->free_snapshots;
+    nec->free_snapshots = nec_snapshot->next_free;
+    nlaevalchan_snapshot_free(nec_snapshot);
+  }
 }
 
 /* Initialize a full NLA evaluation state structure. */
@@ -2627,12 +2691,25 @@ static void nlasnapshot_from_action(PointerRNA *ptr,
   const float modified_evaltime = evaluate_time_fmodifiers(
       &storage, modifiers, NULL, 0.0f, evaltime);
 
+  const char *prev_rna_path = NULL;
+  NlaEvalChannel *prev_nec = NULL;
+
   for (fcu = action->curves.first; fcu; fcu = fcu->next) {
     if (!is_fcurve_evaluatable(fcu)) {
       continue;
     }
 
-    NlaEvalChannel *nec = nlaevalchan_verify(ptr, channels, fcu->rna_path);
+    /* Consecutive F-Curves usually animate elements of the same property, in which case the
+     * look-up in the path hash can be skipped. */
+    NlaEvalChannel *nec;
+    if (prev_rna_path != NULL && fcu->rna_path != NULL && STREQ(prev_rna_path, fcu->rna_path)) {
+      nec = prev_nec;
+    }
+    else {
+      nec = nlaevalchan_verify(ptr, channels, fcu->rna_path);
+      prev_rna_path = fcu->rna_path;
+      prev_nec = nec;
+    }
 
     /* Invalid path or property cannot be animated. */
     if (nec == NULL) {
@@ -258,6 +258,14 @@ typedef struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /**
+   * Linear blend skinning fast path, only used without dual quaternions and deform matrices.
+   * For every vertex group the #eArmatureDefGroupDeform type and, for simple bones, the deform
+   * matrix of the bone stored as three rows of the affine transform.
+   */
+  const char *deform_type_from_defbase;
+  const float (*deform_mat_from_defbase)[3][4];
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -267,6 +275,76 @@ typedef struct ArmatureUserdata {
   } bmesh;
 } ArmatureUserdata;
 
+/* #ArmatureUserdata.deform_type_from_defbase */
+typedef enum eArmatureDefGroupDeform {
+  /* Not a deforming bone. */
+  ARM_DEFGROUP_DEFORM_NONE = 0,
+  /* Bone deforming with its channel matrix only. */
+  ARM_DEFGROUP_DEFORM_MATRIX = 1,
+  /* B-Bone or bone multiplying its weight by the envelope, needs the full evaluation. */
+  ARM_DEFGROUP_DEFORM_COMPLEX = 2,
+} eArmatureDefGroupDeform;
+
+/**
+ * Linear blend skinning of a vertex which is only influenced by bones deforming with their
+ * channel matrix. The weighted matrices are summed first so the coordinate is only transformed
+ * once, and the flat 3x4 accumulation is simple enough for the compiler to vectorize.
+ *
+ * \return false when the vertex needs the full evaluation, in which case nothing is written.
+ */
+static bool armature_vert_deform_matrix_blend(const ArmatureUserdata *data,
+                                              const MDeformVert *dvert,
+                                              const float co[3],
+                                              float r_vec[3],
+                                              float *r_contrib)
+{
+  float mat[3][4] = {{0.0f}};
+  float *mat_flat = &mat[0][0];
+  float contrib = 0.0f;
+  bool deformed = false;
+
+  const MDeformWeight *dw = dvert->dw;
+  for (uint j = dvert->totweight; j != 0; j--, dw++) {
+    const uint index = dw->def_nr;
+    if (index >= data->defbase_len) {
+      continue;
+    }
+    switch ((eArmatureDefGroupDeform)data->deform_type_from_defbase[index]) {
+      case ARM_DEFGROUP_DEFORM_NONE:
+        continue;
+      case ARM_DEFGROUP_DEFORM_COMPLEX:
+        return false;
+      case ARM_DEFGROUP_DEFORM_MATRIX:
+        break;
+    }
+
+    deformed = true;
+
+    const float weight = dw->weight;
+    if (weight == 0.0f) {
+      continue;
+    }
+
+    const float *bone_mat_flat = &data->deform_mat_from_defbase[index][0][0];
+    for (int k = 0; k < 12; k++) {
+      mat_flat[k] += weight * bone_mat_flat[k];
+    }
+    contrib += weight;
+  }
+
+  /* Envelope fallback for vertices without any bone group is handled by the full evaluation. */
+  if (!deformed) {
+    return false;
+  }
+
+  for (int k = 0; k < 3; k++) {
+    r_vec[k] = mat[k][0] * co[0] + mat[k][1] * co[1] + mat[k][2] * co[2] + mat[k][3] -
+               contrib * co[k];
+  }
+  *r_contrib = contrib;
+  return true;
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -339,7 +417,12 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   /* Apply the object's matrix */
   mul_m4_v3(data->premat, co);
 
-  if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
+  if (use_dverts && dvert && dvert->totweight && data->deform_type_from_defbase &&
+      armature_vert_deform_matrix_blend(data, dvert, co, vec, &contrib))
+  {
+    /* Handled by the linear blend skinning fast path. */
+  }
+  else if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     uint j;
@@ -489,6 +572,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 {
   const bArmature *arm = ob_arm->data;
   bPoseChannel **pchan_from_defbase = NULL;
+  char *deform_type_from_defbase = NULL;
+  float(*deform_mat_from_defbase)[3][4] = NULL;
   const MDeformVert *dverts = NULL;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
   const bool use_quaternion = (deformflag & ARM_DEF_QUATERNION) != 0;
@@ -574,6 +659,33 @@ static void armature_deform_coords_impl(const Object *ob_arm,
             }
           }
         }
+
+        if (!use_quaternion && vert_deform_mats == NULL && defbase_len > 0) {
+          deform_type_from_defbase = MEM_callocN(sizeof(*deform_type_from_defbase) * defbase_len,
+                                                 "defnrToDeformType");
+          deform_mat_from_defbase = MEM_mallocN(sizeof(*deform_mat_from_defbase) * defbase_len,
+                                                "defnrToDeformMat");
+          for (i = 0; i < defbase_len; i++) {
+            const bPoseChannel *pchan = pchan_from_defbase[i];
+            if (pchan == NULL) {
+              deform_type_from_defbase[i] = ARM_DEFGROUP_DEFORM_NONE;
+              continue;
+            }
+            const Bone *bone = pchan->bone;
+            if ((bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) ||
+                (bone->flag & BONE_MULT_VG_ENV))
+            {
+              deform_type_from_defbase[i] = ARM_DEFGROUP_DEFORM_COMPLEX;
+              continue;
+            }
+            deform_type_from_defbase[i] = ARM_DEFGROUP_DEFORM_MATRIX;
+            for (int row = 0; row < 3; row++) {
+              for (int col = 0; col < 4; col++) {
+                deform_mat_from_defbase[i][row][col] = pchan->chan_mat[col][row];
+              }
+            }
+          }
+        }
       }
     }
   }
@@ -593,6 +705,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .dverts_len = dverts_len,
       .pchan_from_defbase = pchan_from_defbase,
       .defbase_len = defbase_len,
+      .deform_type_from_defbase = deform_type_from_defbase,
+      .deform_mat_from_defbase = (const float(*)[3][4])deform_mat_from_defbase,
       .bmesh =
           {
               .cd_dvert_offset = cd_dvert_offset,
@@ -632,6 +746,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   if (pchan_from_defbase) {
     MEM_freeN(pchan_from_defbase);
   }
+  MEM_SAFE_FREE(deform_type_from_defbase);
+  MEM_SAFE_FREE(deform_mat_from_defbase);
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
@@ -41,6 +41,8 @@
 #include "RNA_access.h"
 #include "RNA_path.h"
 
+#include "atomic_ops.h"
+
 #include "CLG_log.h"
 
 #define SMALL -1.0e-10
@@ -1995,11 +1997,43 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
-static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
+/**
+ * Find the keyframe that ends the segment containing `evaltime` by checking the segment found by
+ * the previous evaluation of the curve and the one after it. Evaluation time mostly advances in
+ * small steps, so this avoids the binary search for most evaluations of long curves.
+ *
+ * Only segments where `evaltime` is not within the binary search threshold of any of the keys are
+ * accepted, in which case the result is the same as the one of the binary search.
+ *
+ * \return the index of the keyframe, or 0 when the hint is not usable.
+ */
+static uint fcurve_eval_segment_from_hint(const FCurve *fcu,
+                                          const BezTriple *bezts,
+                                          const float evaltime,
+                                          const float threshold)
+{
+  /* The hint is shared by all users of the curve, which may evaluate it from different threads.
+   * It is only ever used after validating it against the keyframes. */
+  const int hint = atomic_load_int32(&fcu->eval_segment_hint);
+
+  for (int a = hint; a <= hint + 1; a++) {
+    if (a < 1 || a >= (int)fcu->totvert) {
+      continue;
+    }
+    if (bezts[a - 1].vec[1][0] + threshold < evaltime && evaltime < bezts[a].vec[1][0] - threshold)
+    {
+      return (uint)a;
+    }
+  }
+  return 0;
+}
+
+static float fcurve_eval_keyframes_interpolate(FCurve *fcu,
                                                const BezTriple *bezts,
                                                float evaltime)
 {
   const float eps = 1.e-8f;
+  const float threshold = 0.0001f;
   uint a;
 
   /* Evaltime occurs somewhere in the middle of the curve. */
@@ -2015,7 +2049,13 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  a = fcurve_eval_segment_from_hint(fcu, bezts, evaltime, threshold);
+  if (a == 0) {
+    a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, threshold, &exact);
+    if (!exact) {
+      atomic_store_int32(&fcu->eval_segment_hint, (int)a);
+    }
+  }
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2615,6 +2655,8 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, ListBase *fcurves)
     /* group */
     BLO_read_data_address(reader, &fcu->grp);
 
+    fcu->eval_segment_hint = 0;
+
     /* clear disabled flag - allows disabled drivers to be tried again (#32155),
      * but also means that another method for "reviving disabled F-Curves" exists
      */
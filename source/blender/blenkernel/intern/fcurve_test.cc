@@ -81,6 +81,39 @@ TEST(evaluate_fcurve, InterpolationLinear)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 8; i++) {
+    insert_vert_fcurve(
+        fcu, float(i * 2), float(i * 10), BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+    fcu->bezt[i].ipo = BEZT_IPO_LIN;
+  }
+
+  /* Advancing time, reusing the segment of the previous evaluation or moving to the next one. */
+  EXPECT_NEAR(evaluate_fcurve(fcu, 0.5f), 2.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 1.5f), 7.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 2.5f), 12.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 4.0f), 20.0f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 4.5f), 22.5f, EPSILON);
+
+  /* Jumping backward and forward over several segments. */
+  EXPECT_NEAR(evaluate_fcurve(fcu, 0.25f), 1.25f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 13.5f), 67.5f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 6.0f), 30.0f, EPSILON);
+
+  /* A hint which is out of date after editing the keys must not be used. */
+  fcu->eval_segment_hint = 7;
+  fcu->totvert = 7;
+  EXPECT_NEAR(evaluate_fcurve(fcu, 11.0f), 55.0f, EPSILON);
+  fcu->eval_segment_hint = 100;
+  EXPECT_NEAR(evaluate_fcurve(fcu, 3.0f), 15.0f, EPSILON);
+  fcu->totvert = 8;
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(evaluate_fcurve, InterpolationBezier)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -9,13 +9,19 @@
 #include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <memory>
+#include <mutex>
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
+#include "BLI_map.hh"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_string_utils.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -52,12 +58,42 @@
 
 #include "BLO_read_write.h"
 
-static void shapekey_copy_data(Main * /*bmain*/, ID *id_dst, const ID *id_src, const int /*flag*/)
+namespace blender::bke {
+
+/**
+ * Offsets of a relative shape key from its reference key, only for the elements which actually
+ * move. Shape keys of face rigs typically only move a small part of the mesh.
+ */
+struct KeyBlockSparseDeltas {
+  /* The data the deltas were computed from, to detect when they are outdated. */
+  const void *data = nullptr;
+  const void *ref_data = nullptr;
+  int totelem = 0;
+
+  /* False when too many elements move for the sparse deltas to be worth storing. */
+  bool is_sparse = false;
+  Array<int> indices;
+  Array<float3> offsets;
+};
+
+struct KeyRuntime {
+  std::mutex sparse_deltas_mutex;
+  Map<const KeyBlock *, std::unique_ptr<KeyBlockSparseDeltas>> sparse_deltas;
+};
+
+}  // namespace blender::bke
+
+static void shapekey_copy_data(Main * /*bmain*/, ID *id_dst, const ID *id_src, const int flag)
 {
   Key *key_dst = (Key *)id_dst;
   const Key *key_src = (const Key *)id_src;
   BLI_duplicatelist(&key_dst->block, &key_src->block);
 
+  /* The key-block data of copy-on-write keys is only changed by copying it again, so only those
+   * can cache data derived from it. */
+  key_dst->runtime = (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) ? new blender::bke::KeyRuntime() :
+                                                                nullptr;
+
   KeyBlock *kb_dst, *kb_src;
   for (kb_src = static_cast<KeyBlock *>(key_src->block.first),
       kb_dst = static_cast<KeyBlock *>(key_dst->block.first);
@@ -78,6 +114,9 @@ static void shapekey_free_data(ID *id)
   Key *key = (Key *)id;
   KeyBlock *kb;
 
+  delete key->runtime;
+  key->runtime = nullptr;
+
   while ((kb = static_cast<KeyBlock *>(BLI_pophead(&key->block)))) {
     if (kb->data) {
       MEM_freeN(kb->data);
@@ -107,6 +146,8 @@ static void shapekey_blend_write(BlendWriter *writer, ID *id, const void *id_add
   Key *key = (Key *)id;
   const bool is_undo = BLO_write_is_undo(writer);
 
+  key->runtime = nullptr;
+
   /* write LibData */
   BLO_write_id_struct(writer, Key, id_address, &key->id);
   BKE_id_blend_write(writer, &key->id);
@@ -172,6 +213,8 @@ static void shapekey_blend_read_data(BlendDataReader *reader, ID *id)
 
   BLO_read_data_address(reader, &key->refkey);
 
+  key->runtime = nullptr;
+
   LISTBASE_FOREACH (KeyBlock *, kb, &key->block) {
     BLO_read_data_address(reader, &kb->data);
 
@@ -247,6 +290,9 @@ void BKE_key_free_nolib(Key *key)
 {
   KeyBlock *kb;
 
+  delete key->runtime;
+  key->runtime = nullptr;
+
   while ((kb = static_cast<KeyBlock *>(BLI_pophead(&key->block)))) {
     if (kb->data) {
       MEM_freeN(kb->data);
@@ -864,6 +910,111 @@ static void cp_cu_key(Curve *cu,
   }
 }
 
+/**
+ * Get the offsets of \a kb from its reference key \a refb, computing them the first time they
+ * are needed. Returns null when they can't be cached.
+ */
+static const blender::bke::KeyBlockSparseDeltas *keyblock_sparse_deltas_ensure(
+    Key *key, const KeyBlock *kb, const KeyBlock *refb)
+{
+  using namespace blender;
+  using namespace blender::bke;
+
+  if (key->runtime == nullptr || refb->totelem != kb->totelem) {
+    return nullptr;
+  }
+
+  /* The same key is evaluated concurrently by all objects using the same mesh. */
+  KeyRuntime &runtime = *key->runtime;
+  std::lock_guard lock(runtime.sparse_deltas_mutex);
+
+  std::unique_ptr<KeyBlockSparseDeltas> &deltas = runtime.sparse_deltas.lookup_or_add_default(kb);
+  if (deltas && deltas->data == kb->data && deltas->ref_data == refb->data &&
+      deltas->totelem == kb->totelem)
+  {
+    return deltas.get();
+  }
+  deltas = std::make_unique<KeyBlockSparseDeltas>();
+  deltas->data = kb->data;
+  deltas->ref_data = refb->data;
+  deltas->totelem = kb->totelem;
+
+  const Span<float3> positions(static_cast<const float3 *>(kb->data), kb->totelem);
+  const Span<float3> ref_positions(static_cast<const float3 *>(refb->data), refb->totelem);
+
+  int moving_num = 0;
+  for (const int i : positions.index_range()) {
+    if (positions[i] != ref_positions[i]) {
+      moving_num++;
+    }
+  }
+
+  /* Blending the dense arrays is cheaper when most of the elements move. */
+  deltas->is_sparse = moving_num <= kb->totelem / 2;
+  if (!deltas->is_sparse) {
+    return deltas.get();
+  }
+
+  deltas->indices.reinitialize(moving_num);
+  deltas->offsets.reinitialize(moving_num);
+  int delta_index = 0;
+  for (const int i : positions.index_range()) {
+    if (positions[i] != ref_positions[i]) {
+      deltas->indices[delta_index] = i;
+      deltas->offsets[delta_index] = positions[i] - ref_positions[i];
+      delta_index++;
+    }
+  }
+
+  return deltas.get();
+}
+
+/**
+ * Fast path of #key_evaluate_relative for keys of meshes and lattices, where every element is a
+ * single coordinate. Only the elements which differ from the reference key are blended when the
+ * key is sparse, and large keys are blended from multiple threads. Elements are blended exactly
+ * as #rel_flerp does, and in the same order of key-blocks, so the result doesn't change.
+ */
+static void key_evaluate_relative_coords(Key *key,
+                                         const KeyBlock *kb,
+                                         const KeyBlock *refb,
+                                         const int start,
+                                         const int end,
+                                         float (*poin)[3],
+                                         const float (*from)[3],
+                                         const float *weights,
+                                         const float icuval)
+{
+  using namespace blender;
+
+  /* The edit-mode coordinates of the active key are not cached. */
+  const bool use_sparse = start == 0 && end == kb->totelem && from == kb->data;
+  const bke::KeyBlockSparseDeltas *deltas = use_sparse ?
+                                                keyblock_sparse_deltas_ensure(key, kb, refb) :
+                                                nullptr;
+
+  if (deltas && deltas->is_sparse) {
+    const Span<int> indices = deltas->indices;
+    const Span<float3> offsets = deltas->offsets;
+    threading::parallel_for(indices.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int index = indices[i];
+        const float weight = weights ? (weights[index] * icuval) : icuval;
+        madd_v3_v3fl(poin[index], offsets[i], weight);
+      }
+    });
+    return;
+  }
+
+  const float(*reffrom)[3] = static_cast<const float(*)[3]>(refb->data);
+  threading::parallel_for(IndexRange(start, end - start), 4096, [&](const IndexRange range) {
+    for (const int b : range) {
+      const float weight = weights ? (weights[b - start] * icuval) : icuval;
+      rel_flerp(KEYELEM_FLOAT_LEN_COORD, poin[b], reffrom[b], from[b], weight);
+    }
+  });
+}
+
 static void key_evaluate_relative(const int start,
                                   int end,
                                   const int tot,
@@ -897,6 +1048,12 @@ static void key_evaluate_relative(const int start,
   /* just here, not above! */
   elemsize = key->elemsize * step;
 
+  /* Keys of meshes and lattices, where every element is a single coordinate. */
+  const bool is_coords = mode == KEY_MODE_DUMMY && step == 1 &&
+                         key->elemsize == sizeof(float[KEYELEM_FLOAT_LEN_COORD]) &&
+                         key->elemstr[0] == KEYELEM_FLOAT_LEN_COORD &&
+                         key->elemstr[1] == IPO_FLOAT && key->elemstr[2] == 0;
+
   /* step 1 init */
   cp_key(start, end, tot, basispoin, key, actkb, key->refkey, nullptr, mode);
 
@@ -924,6 +1081,22 @@ static void key_evaluate_relative(const int start,
         poin = basispoin;
         from = key_block_get_data(key, actkb, kb, &freefrom);
 
+        if (is_coords) {
+          key_evaluate_relative_coords(key,
+                                       kb,
+                                       refb,
+                                       start,
+                                       end,
+                                       (float(*)[3])basispoin,
+                                       (const float(*)[3])from,
+                                       weights,
+                                       icuval);
+          if (freefrom) {
+            MEM_freeN(freefrom);
+          }
+          continue;
+        }
+
         /* For meshes, use the original values instead of the bmesh values to
          * maintain a constant offset. */
         reffrom = static_cast<char *>(refb->data);
@@ -10,6 +10,7 @@
  * \see bmesh_mesh_normals.c for the equivalent #BMesh functionality.
  */
 
+#include <algorithm>
 #include <climits>
 
 #include "MEM_guardedalloc.h"
@@ -17,6 +18,7 @@
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
 #include "BLI_linklist.h"
@@ -27,6 +29,7 @@
 #include "BLI_task.hh"
 #include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector_set.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.h"
@@ -98,6 +101,7 @@ float (*BKE_mesh_vert_normals_for_write(Mesh *mesh))[3]
 void BKE_mesh_vert_normals_clear_dirty(Mesh *mesh)
 {
   mesh->runtime->vert_normals_dirty = false;
+  mesh->runtime->normals_dirty_verts.clear_and_shrink();
   BLI_assert(mesh->runtime->vert_normals.size() == mesh->totvert);
 }
 
@@ -282,6 +286,73 @@ void normals_calc_poly_vert(const Span<float3> positions,
   }
 }
 
+/**
+ * Update face and vertex normals which were valid before the vertices in \a dirty_verts moved.
+ * Only the faces using these vertices and the vertices of those faces can change, they are found
+ * with \a vert_to_poly_map, so the cost only depends on the number of moved vertices.
+ */
+static void normals_update_partial(const Span<float3> positions,
+                                   const OffsetIndices<int> polys,
+                                   const Span<int> corner_verts,
+                                   const GroupedSpan<int> vert_to_poly_map,
+                                   const Span<int> dirty_verts,
+                                   MutableSpan<float3> poly_normals,
+                                   MutableSpan<float3> vert_normals)
+{
+  /* The moved vertices themselves are updated too, in case they are loose. */
+  VectorSet<int> update_polys;
+  VectorSet<int> update_verts;
+  for (const int vert : dirty_verts) {
+    update_verts.add(vert);
+    update_polys.add_multiple(vert_to_poly_map[vert]);
+  }
+  for (const int poly_i : update_polys) {
+    update_verts.add_multiple(corner_verts.slice(polys[poly_i]));
+  }
+
+  threading::parallel_for(update_polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int poly_i : update_polys.as_span().slice(range)) {
+      poly_normals[poly_i] = poly_normal_calc(positions, corner_verts.slice(polys[poly_i]));
+    }
+  });
+
+  /* Accumulate the angle weighted normals of the faces around every updated vertex, the same way
+   * as #normals_calc_poly_vert. */
+  threading::parallel_for(update_verts.index_range(), 1024, [&](const IndexRange range) {
+    for (const int vert : update_verts.as_span().slice(range)) {
+      float3 normal(0);
+      const Span<int> vert_polys = vert_to_poly_map[vert];
+      for (const int i : vert_polys.index_range()) {
+        const int poly_i = vert_polys[i];
+        /* A face using the vertex more than once is contained once for every corner. */
+        if (i > 0 && vert_polys[i - 1] == poly_i) {
+          continue;
+        }
+        const IndexRange poly = polys[poly_i];
+        for (const int corner : poly) {
+          if (corner_verts[corner] != vert) {
+            continue;
+          }
+          const float3 &v_prev = positions[corner_verts[poly_corner_prev(poly, corner)]];
+          const float3 &v_curr = positions[vert];
+          const float3 &v_next = positions[corner_verts[poly_corner_next(poly, corner)]];
+          const float3 edvec_prev = math::normalize(v_prev - v_curr);
+          const float3 edvec_next = math::normalize(v_curr - v_next);
+          const float fac = saacos(-math::dot(edvec_prev, edvec_next));
+          normal += poly_normals[poly_i] * fac;
+        }
+      }
+
+      float *no = vert_normals[vert];
+      copy_v3_v3(no, normal);
+      if (UNLIKELY(normalize_v3(no) == 0.0f)) {
+        /* Following Mesh convention; we use vertex coordinate itself for normal in this case. */
+        normalize_v3_v3(no, positions[vert]);
+      }
+    }
+  });
+}
+
 /** \} */
 
 }  // namespace blender::bke::mesh
@@ -290,6 +361,45 @@ void normals_calc_poly_vert(const Span<float3> positions,
 /** \name Mesh Normal Calculation
  * \{ */
 
+/**
+ * Update the cached normals incrementally when only some vertices moved since they were valid
+ * (see #blender::bke::mesh::tag_positions_changed_partial). Returns false when they have to be
+ * recomputed for the whole mesh instead.
+ */
+static bool mesh_normals_try_update_partial(const Mesh &mesh)
+{
+  using namespace blender;
+  bke::MeshRuntime &runtime = *mesh.runtime;
+  const Vector<int> dirty_verts = std::move(runtime.normals_dirty_verts);
+
+  if (dirty_verts.is_empty()) {
+    return false;
+  }
+  if (runtime.vert_normals.size() != mesh.totvert || runtime.poly_normals.size() != mesh.totpoly)
+  {
+    return false;
+  }
+
+  const OffsetIndices polys = mesh.polys();
+  const Span<int> corner_verts = mesh.corner_verts();
+
+  runtime.vert_to_poly_map_cache.ensure([&](bke::VertToPolyMapCache &r_data) {
+    bke::mesh::build_vert_to_poly_map(
+        polys, corner_verts, mesh.totvert, r_data.offsets, r_data.indices);
+  });
+  const bke::VertToPolyMapCache &vert_to_poly = runtime.vert_to_poly_map_cache.data();
+
+  bke::mesh::normals_update_partial(mesh.vert_positions(),
+                                    polys,
+                                    corner_verts,
+                                    {OffsetIndices<int>(vert_to_poly.offsets),
+                                     vert_to_poly.indices},
+                                    dirty_verts,
+                                    runtime.poly_normals,
+                                    runtime.vert_normals);
+  return true;
+}
+
 blender::Span<blender::float3> Mesh::vert_normals() const
 {
   using namespace blender;
@@ -306,6 +416,12 @@ blender::Span<blender::float3> Mesh::vert_normals() const
 
   /* Isolate task because a mutex is locked and computing normals is multi-threaded. */
   threading::isolate_task([&]() {
+    if (mesh_normals_try_update_partial(*this)) {
+      this->runtime->vert_normals_dirty = false;
+      this->runtime->poly_normals_dirty = false;
+      return;
+    }
+
     const Span<float3> positions = this->vert_positions();
     const OffsetIndices polys = this->polys();
     const Span<int> corner_verts = this->corner_verts();
@@ -338,6 +454,13 @@ blender::Span<blender::float3> Mesh::poly_normals() const
 
   /* Isolate task because a mutex is locked and computing normals is multi-threaded. */
   threading::isolate_task([&]() {
+    /* Vertex normals are updated as well, but that is cheap when only a few vertices moved. */
+    if (mesh_normals_try_update_partial(*this)) {
+      this->runtime->vert_normals_dirty = false;
+      this->runtime->poly_normals_dirty = false;
+      return;
+    }
+
     const Span<float3> positions = this->vert_positions();
     const OffsetIndices polys = this->polys();
     const Span<int> corner_verts = this->corner_verts();
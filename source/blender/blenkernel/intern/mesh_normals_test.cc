@@ -0,0 +1,130 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_idtype.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_types.h"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::bke::tests {
+
+/**
+ * Create a grid of quads with a wavy surface, followed by a few loose vertices.
+ */
+static Mesh *create_wavy_grid(const int size, const int loose_verts_num)
+{
+  const int grid_verts_num = size * size;
+  const int polys_num = (size - 1) * (size - 1);
+  Mesh *mesh = BKE_mesh_new_nomain(grid_verts_num + loose_verts_num, 0, polys_num, polys_num * 4);
+
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int y : IndexRange(size)) {
+    for (const int x : IndexRange(size)) {
+      positions[y * size + x] = float3(x, y, std::sin(x * 0.7f) * std::cos(y * 0.4f));
+    }
+  }
+  for (const int i : IndexRange(loose_verts_num)) {
+    positions[grid_verts_num + i] = float3(i, -1.0f, 1.0f);
+  }
+
+  MutableSpan<int> poly_offsets = mesh->poly_offsets_for_write();
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int y : IndexRange(size - 1)) {
+    for (const int x : IndexRange(size - 1)) {
+      const int poly_i = y * (size - 1) + x;
+      poly_offsets[poly_i] = poly_i * 4;
+      corner_verts[poly_i * 4 + 0] = y * size + x;
+      corner_verts[poly_i * 4 + 1] = y * size + x + 1;
+      corner_verts[poly_i * 4 + 2] = (y + 1) * size + x + 1;
+      corner_verts[poly_i * 4 + 3] = (y + 1) * size + x;
+    }
+  }
+
+  BKE_mesh_tag_topology_changed(mesh);
+  return mesh;
+}
+
+static void move_verts(Mesh *mesh, const Span<int> verts, const float3 &offset)
+{
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int vert : verts) {
+    positions[vert] += offset;
+  }
+  IndexMaskMemory memory;
+  mesh::tag_positions_changed_partial(*mesh, IndexMask::from_indices(verts, memory));
+}
+
+/** Compare the cached normals of the mesh against normals computed from scratch. */
+static void expect_normals_match_full_calculation(const Mesh *mesh)
+{
+  Array<float3> poly_normals(mesh->totpoly);
+  Array<float3> vert_normals(mesh->totvert);
+  mesh::normals_calc_poly_vert(
+      mesh->vert_positions(), mesh->polys(), mesh->corner_verts(), poly_normals, vert_normals);
+
+  const Span<float3> mesh_poly_normals = mesh->poly_normals();
+  const Span<float3> mesh_vert_normals = mesh->vert_normals();
+  for (const int i : poly_normals.index_range()) {
+    EXPECT_V3_NEAR(mesh_poly_normals[i], poly_normals[i], 1e-5f);
+  }
+  for (const int i : vert_normals.index_range()) {
+    EXPECT_V3_NEAR(mesh_vert_normals[i], vert_normals[i], 1e-5f);
+  }
+}
+
+TEST(mesh_normals, PartialUpdate)
+{
+  BKE_idtype_init();
+  Mesh *mesh = create_wavy_grid(32, 2);
+  const int loose_vert = 32 * 32;
+
+  /* Calculate the normals once, so that they can be updated partially. */
+  mesh->vert_normals();
+  mesh->poly_normals();
+
+  move_verts(mesh, {0, 33, 100, 101, 500, loose_vert}, float3(0.1f, -0.2f, 0.5f));
+  expect_normals_match_full_calculation(mesh);
+
+  /* Tagging repeatedly before the normals are accessed, also including vertices tagged before. */
+  move_verts(mesh, {100, 200, 201, 1023}, float3(0.0f, 0.0f, -0.3f));
+  move_verts(mesh, {101, 200, loose_vert + 1}, float3(0.2f, 0.1f, 0.0f));
+  expect_normals_match_full_calculation(mesh);
+
+  /* Only the face normals are accessed after the update. */
+  move_verts(mesh, {640, 641}, float3(0.0f, 0.4f, 0.4f));
+  const Span<float3> poly_normals = mesh->poly_normals();
+  EXPECT_FALSE(BKE_mesh_vert_normals_are_dirty(mesh));
+  EXPECT_EQ(poly_normals.size(), mesh->totpoly);
+  expect_normals_match_full_calculation(mesh);
+
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST(mesh_normals, PartialUpdateManyVerts)
+{
+  BKE_idtype_init();
+  Mesh *mesh = create_wavy_grid(8, 1);
+  mesh->vert_normals();
+
+  /* More than a quarter of the vertices moved, the normals are calculated from scratch. */
+  Vector<int> verts;
+  for (int vert = 0; vert < mesh->totvert; vert += 2) {
+    verts.append(vert);
+  }
+  move_verts(mesh, verts, float3(0.0f, 0.0f, 1.0f));
+  EXPECT_TRUE(mesh->runtime->normals_dirty_verts.is_empty());
+  expect_normals_match_full_calculation(mesh);
+
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
@@ -85,6 +85,7 @@ static void reset_normals(MeshRuntime &mesh_runtime)
   mesh_runtime.poly_normals.clear_and_shrink();
   mesh_runtime.vert_normals_dirty = true;
   mesh_runtime.poly_normals_dirty = true;
+  mesh_runtime.normals_dirty_verts.clear_and_shrink();
 }
 
 static void free_batch_cache(MeshRuntime &mesh_runtime)
@@ -299,6 +300,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->verts_no_face_cache.tag_dirty();
   mesh->runtime->looptris_cache.tag_dirty();
   mesh->runtime->looptri_polys_cache.tag_dirty();
+  mesh->runtime->vert_to_poly_map_cache.tag_dirty();
   mesh->runtime->subsurf_face_dot_tags.clear_and_shrink();
   mesh->runtime->subsurf_optimal_display_edges.clear_and_shrink();
   if (mesh->runtime->shrinkwrap_data) {
@@ -338,21 +340,60 @@ void BKE_mesh_tag_edges_split(Mesh *mesh)
   }
 }
 
+static void tag_normals_dirty(blender::bke::MeshRuntime &mesh_runtime)
+{
+  mesh_runtime.vert_normals_dirty = true;
+  mesh_runtime.poly_normals_dirty = true;
+  mesh_runtime.normals_dirty_verts.clear_and_shrink();
+}
+
 void BKE_mesh_tag_face_winding_changed(Mesh *mesh)
 {
-  mesh->runtime->vert_normals_dirty = true;
-  mesh->runtime->poly_normals_dirty = true;
+  tag_normals_dirty(*mesh->runtime);
 }
 
 void BKE_mesh_tag_positions_changed(Mesh *mesh)
 {
-  mesh->runtime->vert_normals_dirty = true;
-  mesh->runtime->poly_normals_dirty = true;
+  tag_normals_dirty(*mesh->runtime);
   free_bvh_cache(*mesh->runtime);
   mesh->runtime->looptris_cache.tag_dirty();
   mesh->runtime->bounds_cache.tag_dirty();
 }
 
+namespace blender::bke::mesh {
+
+void tag_positions_changed_partial(Mesh &mesh, const IndexMask &changed_verts)
+{
+  if (changed_verts.is_empty()) {
+    return;
+  }
+
+  MeshRuntime &runtime = *mesh.runtime;
+  const bool normals_valid = !runtime.vert_normals_dirty && !runtime.poly_normals_dirty;
+  Vector<int> dirty_verts = std::move(runtime.normals_dirty_verts);
+
+  BKE_mesh_tag_positions_changed(&mesh);
+
+  /* The normals can only be updated incrementally when they were valid before the positions
+   * changed, possibly up to other vertices which moved since then. */
+  if (!normals_valid && dirty_verts.is_empty()) {
+    return;
+  }
+  if (runtime.vert_normals.size() != mesh.totvert || runtime.poly_normals.size() != mesh.totpoly)
+  {
+    return;
+  }
+  /* Updating the normals around the moved vertices is only worth it when few of them moved. */
+  if (dirty_verts.size() + changed_verts.size() > mesh.totvert / 4) {
+    return;
+  }
+
+  changed_verts.foreach_index([&](const int vert) { dirty_verts.append(vert); });
+  runtime.normals_dirty_verts = std::move(dirty_verts);
+}
+
+}  // namespace blender::bke::mesh
+
 void BKE_mesh_tag_positions_changed_uniformly(Mesh *mesh)
 {
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
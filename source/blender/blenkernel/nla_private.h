@@ -74,6 +74,9 @@ typedef struct NlaEvalChannelSnapshot {
   int length;   /* Number of values in the property. */
   bool is_base; /* Base snapshot of the channel. */
 
+  /* Next snapshot in #NlaEvalChannel.free_snapshots, only set while the snapshot is unused. */
+  struct NlaEvalChannelSnapshot *next_free;
+
   float values[]; /* Item values. */
   /* Memory over-allocated to provide space for values. */
 } NlaEvalChannelSnapshot;
@@ -103,6 +106,10 @@ typedef struct NlaEvalChannel {
   /* Associated with the RNA property's value(s), marks which elements are affected by NLA. */
   NlaValidMask domain;
 
+  /* Snapshots of this channel which are not used anymore, reused for the snapshots of the
+   * following strips instead of allocating new ones. Freed together with the channel. */
+  NlaEvalChannelSnapshot *free_snapshots;
+
   /* Base set of values. */
   NlaEvalChannelSnapshot base_snapshot;
   /* Memory over-allocated to provide space for base_snapshot.values. */
@@ -14,14 +14,16 @@
  *  - Literals:
  *      floating point and decimal integer.
  *  - Constants:
- *      pi, True, False
+ *      pi, tau, e, inf, True, False
  *  - Operators:
- *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
+ *      +, -, *, /, //, %, **, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
  *      abs, fabs, floor, ceil, trunc, int,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, expm1, log, log2, log10, log1p,
+ *      sqrt, hypot, pow, fmod, copysign
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -302,6 +304,42 @@ static double op_sub(double a, double b)
   return a - b;
 }
 
+static double op_mod(double a, double b)
+{
+  /* Python semantics: the result has the sign of the divisor. */
+  double result = fmod(a, b);
+  if (result != 0.0 && ((result < 0.0) != (b < 0.0))) {
+    result += b;
+  }
+  return result;
+}
+
+static double op_floordiv(double a, double b)
+{
+  /* Python semantics, ported from `float_floor_div` in CPython. Flooring the plain quotient is
+   * wrong when it is rounded up to an integer, e.g. `1 // 0.1` is 9 and not 10. */
+  if (b == 0.0) {
+    /* Raises the division by zero exception like a regular division. */
+    return a / b;
+  }
+
+  double mod = fmod(a, b);
+  double div = (a - mod) / b;
+  if (mod != 0.0 && ((b < 0.0) != (mod < 0.0))) {
+    div -= 1.0;
+  }
+
+  if (div == 0.0) {
+    return copysign(0.0, a / b);
+  }
+
+  double floordiv = floor(div);
+  if (div - floordiv > 0.5) {
+    floordiv += 1.0;
+  }
+  return floordiv;
+}
+
 static double op_radians(double arg)
 {
   return arg * M_PI / 180.0;
@@ -382,7 +420,14 @@ typedef struct BuiltinConstDef {
 } BuiltinConstDef;
 
 static BuiltinConstDef builtin_consts[] = {
-    {"pi", M_PI}, {"True", 1.0}, {"False", 0.0}, {NULL, 0.0}};
+    {"pi", M_PI},
+    {"tau", M_PI * 2.0},
+    {"e", M_E},
+    {"inf", INFINITY},
+    {"True", 1.0},
+    {"False", 0.0},
+    {NULL, 0.0},
+};
 
 typedef struct BuiltinOpDef {
   const char *name;
@@ -414,12 +459,24 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
+    {"expm1", OPCODE_FUNC1, expm1},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
+    {"log1p", OPCODE_FUNC1, log1p},
     {"sqrt", OPCODE_FUNC1, sqrt},
+    {"hypot", OPCODE_FUNC2, hypot},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"copysign", OPCODE_FUNC2, copysign},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
@@ -454,6 +511,8 @@ static BuiltinOpDef builtin_ops[] = {
 #define TOKEN_NOT MAKE_CHAR2('N', 'O')
 #define TOKEN_IF MAKE_CHAR2('I', 'F')
 #define TOKEN_ELSE MAKE_CHAR2('E', 'L')
+#define TOKEN_POW MAKE_CHAR2('*', '*')
+#define TOKEN_FLOORDIV MAKE_CHAR2('/', '/')
 
 static const char *token_eq_characters = "!=><";
 static const char *token_characters = "~`!@#$%^&*+-=/\\?:;<>(){}[]|.,\"'";
@@ -698,6 +757,13 @@ static bool parse_next_token(ExprParseState *state)
     return true;
   }
 
+  /* Doubled operator tokens: ** and // */
+  if (ELEM(state->cur[0], '*', '/') && state->cur[1] == state->cur[0]) {
+    state->token = MAKE_CHAR2(state->cur[0], state->cur[1]);
+    state->cur += 2;
+    return true;
+  }
+
   /* Special characters (single character tokens) */
   if (strchr(token_characters, *state->cur)) {
     state->token = *state->cur++;
@@ -770,19 +836,11 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
-static bool parse_unary(ExprParseState *state)
+static bool parse_primary(ExprParseState *state)
 {
   int i;
 
   switch (state->token) {
-    case '+':
-      return parse_next_token(state) && parse_unary(state);
-
-    case '-':
-      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
-      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
-      return true;
-
     case '(':
       return parse_next_token(state) && parse_expr(state) && state->token == ')' &&
              parse_next_token(state);
@@ -853,6 +911,37 @@ static bool parse_unary(ExprParseState *state)
   }
 }
 
+static bool parse_unary(ExprParseState *state);
+
+static bool parse_power(ExprParseState *state)
+{
+  CHECK_ERROR(parse_primary(state));
+
+  /* Right associative, and binds tighter than a unary operator on its left: -2**2 == -4. */
+  if (state->token == TOKEN_POW) {
+    CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+    parse_add_func(state, OPCODE_FUNC2, 2, pow);
+  }
+
+  return true;
+}
+
+static bool parse_unary(ExprParseState *state)
+{
+  switch (state->token) {
+    case '+':
+      return parse_next_token(state) && parse_unary(state);
+
+    case '-':
+      CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+      parse_add_func(state, OPCODE_FUNC1, 1, op_negate);
+      return true;
+
+    default:
+      return parse_power(state);
+  }
+}
+
 static bool parse_mul(ExprParseState *state)
 {
   CHECK_ERROR(parse_unary(state));
@@ -869,6 +958,16 @@ static bool parse_mul(ExprParseState *state)
         parse_add_func(state, OPCODE_FUNC2, 2, op_div);
         break;
 
+      case TOKEN_FLOORDIV:
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_floordiv);
+        break;
+
+      case '%':
+        CHECK_ERROR(parse_next_token(state) && parse_unary(state));
+        parse_add_func(state, OPCODE_FUNC2, 2, op_mod);
+        break;
+
       default:
         return true;
     }
@@ -113,6 +113,8 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+TEST_PARSE_FAIL(BadPower, "2 *** 3")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -147,6 +149,8 @@ TEST_CONST(Half, ".5", 0.5)
 TEST_CONST(Pi, "pi", M_PI)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
+TEST_CONST(Tau, "tau", M_PI * 2.0)
+TEST_CONST(E, "e", M_E)
 
 TEST_CONST(Sqrt, "sqrt(4)", 2.0)
 TEST_EVAL(Sqrt, "sqrt(x)", 4.0, 2.0)
@@ -158,6 +162,14 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(1000)", 3.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_EVAL(Hypot, "hypot(x, 4)", 3.0, 5.0)
+
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+TEST_EVAL(Tanh, "tanh(x)", 0.0, 0.0)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -207,6 +219,29 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(FloorDiv1, "7 // 2", 3.0)
+TEST_CONST(FloorDiv2, "-7 // 2", -4.0)
+TEST_CONST(FloorDiv3, "1 // 0.1", 9.0)
+TEST_CONST(FloorDiv4, "-1 // 0.1", -10.0)
+TEST_CONST(FloorDiv5, "1 // -0.1", -10.0)
+TEST_CONST(FloorDiv6, "-1 // -0.1", 9.0)
+TEST_CONST(FloorDiv7, "-7.5 // -2", 3.0)
+TEST_CONST(FloorDiv8, "7 // -2", -4.0)
+TEST_EVAL(FloorDiv, "x // 2", -7, -4.0)
+TEST_EVAL(FloorDiv2, "x // 0.1", 0.3, 2.0)
+
+TEST_CONST(Mod1, "7 % 3", 1.0)
+TEST_CONST(Mod2, "-7 % 3", 2.0)
+TEST_CONST(Mod3, "7 % -3", -2.0)
+TEST_EVAL(Mod, "x % 1", -0.25, 0.75)
+
+TEST_CONST(Power1, "2 ** 3", 8.0)
+TEST_CONST(Power2, "-2 ** 2", -4.0)
+TEST_CONST(Power3, "2 ** -1", 0.5)
+TEST_CONST(Power4, "2 ** 3 ** 2", 512.0)
+TEST_EVAL(Power1, "x ** 2", 3.0, 9.0)
+TEST_EVAL(Power2, "-x ** 2", 3.0, -9.0)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -331,6 +366,10 @@ TEST_ERROR(DivZero1, "0 / 0", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(DivZero2, "1 / 0", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(DivZero3, "1 / x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(DivZero4, "1 / x", 1.0, EXPR_PYLIKE_SUCCESS)
+TEST_ERROR(DivZero5, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(DivZero6, "1 % x", 0.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(DivZero7, "x // 0", 1.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(DivZero8, "x // 0", -2.5, EXPR_PYLIKE_DIV_BY_ZERO)
 
 TEST_ERROR(SqrtDomain1, "sqrt(-1)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(SqrtDomain2, "sqrt(x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
@@ -43,6 +43,18 @@ void DEG_stats_simple(const struct Depsgraph *graph,
                       size_t *r_operations,
                       size_t *r_relations);
 
+/**
+ * Replay the last evaluation of the graph with the operation timings recorded during it,
+ * simulating the scheduling of operations on the given number of threads. Allows to compare
+ * scheduling policies without evaluating the scene again.
+ *
+ * Requires the last evaluation to happen with #G_DEBUG_DEPSGRAPH_TIME enabled.
+ * \return The time in seconds the evaluation would have taken.
+ */
+double DEG_debug_eval_schedule_replay(const struct Depsgraph *graph,
+                                      int num_threads,
+                                      bool use_critical_path);
+
 /* ************************************************ */
 /* Diagram-Based Graph Debugging */
 
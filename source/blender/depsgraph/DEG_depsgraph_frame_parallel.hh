@@ -0,0 +1,100 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Evaluation of a range of frames on several dependency graphs at once.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "DEG_depsgraph.h"
+
+struct Main;
+struct Scene;
+struct TaskPool;
+struct ViewLayer;
+
+namespace blender::deg {
+
+/**
+ * Evaluates a list of frames on a set of independent dependency graphs, several frames at a time,
+ * and hands the evaluated dependency graphs to the caller in the order of the frames.
+ *
+ * This is meant for exporters and bakes which step through a frame range and only read the
+ * evaluated state of every frame. It is only valid when the evaluation of a frame does not depend
+ * on the evaluation of the previous ones: frame change handlers are not run, and neither sound nor
+ * image sequences are updated, so the result must only depend on the animation system, drivers,
+ * constraints and modifiers.
+ *
+ * Every frame in flight holds a fully evaluated copy of the scene, so the memory usage grows
+ * linearly with `max_frames_in_flight`. A frame is only evaluated once the previous evaluation on
+ * the same dependency graph was consumed.
+ *
+ * The caller must not hold the Python GIL while waiting for frames, as Python drivers are
+ * evaluated from the worker threads.
+ */
+class FrameParallelEvaluator : NonCopyable, NonMovable {
+ public:
+  /* Build the relations of a newly created dependency graph, for example with
+   * #DEG_graph_build_from_view_layer. Called once for every dependency graph. */
+  using BuildFn = FunctionRef<void(::Depsgraph *depsgraph)>;
+
+ private:
+  struct FrameSlot {
+    ::Depsgraph *depsgraph = nullptr;
+    double frame = 0.0;
+    bool is_evaluated = false;
+  };
+
+  Vector<double> frames_;
+  Array<FrameSlot> slots_;
+
+  TaskPool *task_pool_ = nullptr;
+  std::mutex mutex_;
+  std::condition_variable evaluated_condition_;
+
+  /* Index in #frames_ of the next frame to be scheduled for evaluation. */
+  int64_t scheduled_index_ = 0;
+  /* Index in #frames_ of the next frame to be returned from #next_frame. */
+  int64_t consumed_index_ = 0;
+
+ public:
+  FrameParallelEvaluator(Main *bmain,
+                         Scene *scene,
+                         ViewLayer *view_layer,
+                         eEvaluationMode mode,
+                         BuildFn build_fn,
+                         Span<double> frames,
+                         int max_frames_in_flight);
+  ~FrameParallelEvaluator();
+
+  /**
+   * Wait for the evaluation of the next frame, and return the dependency graph which has been
+   * evaluated for it. The dependency graph stays valid until the next call to this function or
+   * the destruction of the evaluator. Returns nullptr once all frames have been returned.
+   */
+  ::Depsgraph *next_frame(double *r_frame);
+
+  int64_t frames_num() const
+  {
+    return frames_.size();
+  }
+
+ private:
+  void schedule_next_frame();
+  static void evaluate_frame_task(TaskPool *pool, void *taskdata);
+};
+
+}  // namespace blender::deg
@@ -57,6 +57,9 @@ struct CyclesSolverState {
   Depsgraph *graph;
   BLI_Stack *traversal_stack;
   int num_cycles = 0;
+  /* Index in the graph operations from which to continue looking for nodes which were not
+   * checked yet. All nodes before it have been visited already. */
+  int64_t non_checked_node_index = 0;
 };
 
 inline void set_node_visited_state(Node *node, eCyclicCheckVisitedState state)
@@ -114,7 +117,11 @@ void schedule_leaf_nodes(CyclesSolverState *state)
  */
 bool schedule_non_checked_node(CyclesSolverState *state)
 {
-  for (OperationNode *node : state->graph->operations) {
+  const Span<OperationNode *> operations = state->graph->operations;
+  /* Nodes never go back to the not visited state, so there is no need to check the nodes before
+   * the previously scheduled one again. */
+  for (; state->non_checked_node_index < operations.size(); state->non_checked_node_index++) {
+    OperationNode *node = operations[state->non_checked_node_index];
     if (get_node_visited_state(node) == NODE_NOT_VISITED) {
       schedule_node_to_stack(state, node);
       return true;
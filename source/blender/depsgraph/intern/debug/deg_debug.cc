@@ -8,6 +8,8 @@
 
 #include "intern/debug/deg_debug.h"
 
+#include <cinttypes>
+
 #include "BLI_console.h"
 #include "BLI_hash.h"
 #include "BLI_string.h"
@@ -20,7 +22,11 @@
 namespace blender::deg {
 
 DepsgraphDebug::DepsgraphDebug()
-    : flags(G.debug), is_ever_evaluated(false), graph_evaluation_start_time_(0)
+    : flags(G.debug),
+      is_ever_evaluated(false),
+      graph_evaluation_start_time_(0),
+      cow_updates_num_(0),
+      cow_copied_bytes_(0)
 {
 }
 
@@ -42,6 +48,8 @@ void DepsgraphDebug::begin_graph_evaluation()
   }
 
   graph_evaluation_start_time_ = current_time;
+  cow_updates_num_ = 0;
+  cow_copied_bytes_ = 0;
 }
 
 void DepsgraphDebug::end_graph_evaluation()
@@ -53,10 +61,21 @@ void DepsgraphDebug::end_graph_evaluation()
   const double graph_eval_end_time = PIL_check_seconds_timer();
   printf("Depsgraph updated in %f seconds.\n", graph_eval_end_time - graph_evaluation_start_time_);
   printf("Depsgraph evaluation FPS: %f\n", 1.0f / fps_samples_.get_averaged());
+  if (cow_updates_num_ != 0) {
+    printf("Depsgraph copy-on-write: %" PRId64 " data-blocks, %f MiB copied.\n",
+           int64_t(cow_updates_num_),
+           double(cow_copied_bytes_) / (1024.0 * 1024.0));
+  }
 
   is_ever_evaluated = true;
 }
 
+void DepsgraphDebug::add_copy_on_write_update(const int64_t copied_bytes) const
+{
+  cow_updates_num_.fetch_add(1, std::memory_order_relaxed);
+  cow_copied_bytes_.fetch_add(copied_bytes, std::memory_order_relaxed);
+}
+
 bool terminal_do_color()
 {
   return (G.debug & G_DEBUG_DEPSGRAPH_PRETTY) != 0;
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "intern/debug/deg_time_average.h"
 #include "intern/depsgraph_type.h"
 
@@ -26,6 +28,10 @@ class DepsgraphDebug {
   void begin_graph_evaluation();
   void end_graph_evaluation();
 
+  /* Account a copy-on-write update of a data-block which allocated the given amount of memory.
+   * Is thread-safe, called from the evaluation threads. */
+  void add_copy_on_write_update(int64_t copied_bytes) const;
+
   /* NOTE: Corresponds to G_DEBUG_DEPSGRAPH_* flags. */
   int flags;
 
@@ -47,6 +53,11 @@ class DepsgraphDebug {
   double graph_evaluation_start_time_;
 
   AveragedTimeSampler<MAX_FPS_COUNTERS> fps_samples_;
+
+  /* Copy-on-write updates done during the current graph evaluation, and the memory they allocated.
+   * Only gathered when time debug is enabled. */
+  mutable std::atomic<int64_t> cow_updates_num_;
+  mutable std::atomic<int64_t> cow_copied_bytes_;
 };
 
 #define DEG_DEBUG_PRINTF(depsgraph, type, ...) \
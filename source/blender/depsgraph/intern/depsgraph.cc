@@ -202,9 +202,13 @@ Relation *Depsgraph::check_nodes_connected(const Node *from,
                                            const Node *to,
                                            const char *description)
 {
-  for (Relation *rel : from->outlinks) {
-    BLI_assert(rel->from == from);
-    if (rel->to != to) {
+  /* Every relation is stored in both nodes, scan the shorter list. Nodes like the time source
+   * have relations to a large part of the graph, scanning their links for every new relation makes
+   * the graph construction quadratic. */
+  const bool use_inlinks = to->inlinks.size() < from->outlinks.size();
+  const Node::Relations &relations = use_inlinks ? to->inlinks : from->outlinks;
+  for (Relation *rel : relations) {
+    if (rel->from != from || rel->to != to) {
       continue;
     }
     if (description != nullptr && !STREQ(rel->name, description)) {
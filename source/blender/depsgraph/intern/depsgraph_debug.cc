@@ -23,6 +23,7 @@
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_time.h"
@@ -224,6 +225,14 @@ void DEG_stats_simple(const Depsgraph *graph,
   }
 }
 
+double DEG_debug_eval_schedule_replay(const Depsgraph *graph,
+                                      int num_threads,
+                                      bool use_critical_path)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  return deg::deg_eval_stats_replay_schedule(deg_graph, num_threads, use_critical_path);
+}
+
 static deg::string depsgraph_name_for_logging(Depsgraph *depsgraph)
 {
   const char *name = DEG_debug_name_get(depsgraph);
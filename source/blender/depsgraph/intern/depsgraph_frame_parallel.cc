@@ -0,0 +1,116 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Evaluation of a range of frames on several dependency graphs at once.
+ */
+
+#include "DEG_depsgraph_frame_parallel.hh"
+
+#include <algorithm>
+
+#include "BLI_task.h"
+
+#include "DEG_depsgraph.h"
+
+namespace blender::deg {
+
+FrameParallelEvaluator::FrameParallelEvaluator(Main *bmain,
+                                               Scene *scene,
+                                               ViewLayer *view_layer,
+                                               const eEvaluationMode mode,
+                                               const BuildFn build_fn,
+                                               const Span<double> frames,
+                                               const int max_frames_in_flight)
+    : frames_(frames)
+{
+  /* There is no point in having more dependency graphs than frames. */
+  const int64_t slots_num = std::max<int64_t>(
+      1, std::min<int64_t>(max_frames_in_flight, frames_.size()));
+  slots_.reinitialize(slots_num);
+
+  /* Building modifies the registry of dependency graphs and tags data-blocks of the input Main,
+   * so it happens on the calling thread before any evaluation is started. */
+  for (FrameSlot &slot : slots_) {
+    slot.depsgraph = DEG_graph_new(bmain, scene, view_layer, mode);
+    build_fn(slot.depsgraph);
+  }
+
+  /* Background pool, so that frames keep being evaluated while the calling thread waits for the
+   * next one, also when running with a single thread. */
+  task_pool_ = BLI_task_pool_create_background(this, TASK_PRIORITY_LOW);
+
+  std::lock_guard lock(mutex_);
+  for (int64_t i = 0; i < slots_num; i++) {
+    schedule_next_frame();
+  }
+}
+
+FrameParallelEvaluator::~FrameParallelEvaluator()
+{
+  /* Frames which were not consumed yet are not needed anymore. */
+  BLI_task_pool_cancel(task_pool_);
+  BLI_task_pool_free(task_pool_);
+
+  for (FrameSlot &slot : slots_) {
+    DEG_graph_free(slot.depsgraph);
+  }
+}
+
+void FrameParallelEvaluator::schedule_next_frame()
+{
+  if (scheduled_index_ >= frames_.size()) {
+    return;
+  }
+  FrameSlot &slot = slots_[scheduled_index_ % slots_.size()];
+  slot.frame = frames_[scheduled_index_];
+  slot.is_evaluated = false;
+  scheduled_index_++;
+
+  BLI_task_pool_push(task_pool_, evaluate_frame_task, &slot, false, nullptr);
+}
+
+void FrameParallelEvaluator::evaluate_frame_task(TaskPool *pool, void *taskdata)
+{
+  FrameParallelEvaluator *evaluator = static_cast<FrameParallelEvaluator *>(
+      BLI_task_pool_user_data(pool));
+  FrameSlot *slot = static_cast<FrameSlot *>(taskdata);
+
+  /* The evaluation itself is multi-threaded as usual, the frame tasks only make sure the worker
+   * threads have something else to do while one of the frames is stuck on a heavy object. */
+  DEG_evaluate_on_framechange(slot->depsgraph, float(slot->frame));
+
+  {
+    std::lock_guard lock(evaluator->mutex_);
+    slot->is_evaluated = true;
+  }
+  evaluator->evaluated_condition_.notify_all();
+}
+
+::Depsgraph *FrameParallelEvaluator::next_frame(double *r_frame)
+{
+  std::unique_lock lock(mutex_);
+
+  /* The dependency graph returned by the previous call is not used by the caller anymore, so it
+   * can start working on the next frame that did not fit in flight yet. */
+  if (consumed_index_ > 0) {
+    schedule_next_frame();
+  }
+  if (consumed_index_ >= frames_.size()) {
+    return nullptr;
+  }
+
+  FrameSlot &slot = slots_[consumed_index_ % slots_.size()];
+  evaluated_condition_.wait(lock, [&]() { return slot.is_evaluated; });
+  consumed_index_++;
+
+  if (r_frame) {
+    *r_frame = slot.frame;
+  }
+  return slot.depsgraph;
+}
+
+}  // namespace blender::deg
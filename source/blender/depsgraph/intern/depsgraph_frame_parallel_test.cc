@@ -0,0 +1,172 @@
+/* SPDX-FileCopyrightText: 2023 Blender Foundation
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_set.hh"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_vector.hh"
+
+#include "BKE_action.h"
+#include "BKE_anim_data.h"
+#include "BKE_blender.h"
+#include "BKE_callbacks.h"
+#include "BKE_collection.h"
+#include "BKE_fcurve.h"
+#include "BKE_idtype.h"
+#include "BKE_layer.h"
+#include "BKE_main.h"
+#include "BKE_modifier.h"
+#include "BKE_object.h"
+#include "BKE_scene.h"
+
+#include "DNA_anim_types.h"
+#include "DNA_genfile.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "RNA_define.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+#include "DEG_depsgraph_frame_parallel.hh"
+#include "DEG_depsgraph_query.h"
+
+#include "CLG_log.h"
+
+namespace blender::deg::tests {
+
+class FrameParallelEvaluatorTest : public testing::Test {
+ protected:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  Object *object = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    /* Minimal initialization to build and evaluate dependency graphs, see
+     * #BlendfileLoadingBaseTest. */
+    CLG_init();
+    BLI_threadapi_init();
+    DNA_sdna_current_init();
+    BKE_blender_globals_init();
+    BKE_idtype_init();
+    BKE_modifier_init();
+    DEG_register_node_types();
+    RNA_init();
+    BKE_callback_global_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    BKE_blender_free();
+    RNA_exit();
+    DEG_free_node_types();
+    DNA_sdna_current_free();
+    BLI_threadapi_exit();
+    BKE_blender_atexit();
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "Scene");
+    object = BKE_object_add_only_object(bmain, OB_EMPTY, "Empty");
+    BKE_collection_object_add(bmain, scene->master_collection, object);
+
+    /* Animate the X location from 0 at frame 1 to 10 at frame 11. */
+    AnimData *adt = BKE_animdata_ensure_id(&object->id);
+    adt->action = BKE_action_add(bmain, "Action");
+
+    FCurve *fcu = BKE_fcurve_create();
+    fcu->rna_path = BLI_strdup("location");
+    fcu->array_index = 0;
+    fcu->totvert = 2;
+    fcu->bezt = MEM_cnew_array<BezTriple>(2, __func__);
+    for (const int i : IndexRange(2)) {
+      BezTriple &bezt = fcu->bezt[i];
+      for (const int handle : IndexRange(3)) {
+        bezt.vec[handle][0] = 1.0f + i * 10.0f;
+        bezt.vec[handle][1] = i * 10.0f;
+      }
+      bezt.ipo = BEZT_IPO_LIN;
+      bezt.h1 = bezt.h2 = HD_AUTO_ANIM;
+    }
+    BKE_fcurve_handles_recalc(fcu);
+    BLI_addtail(&adt->action->curves, fcu);
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+  }
+};
+
+TEST_F(FrameParallelEvaluatorTest, FramesInOrder)
+{
+  const Vector<double> frames = {1.0, 2.0, 2.5, 4.0, 5.0, 6.0, 8.0, 11.0};
+  const int max_frames_in_flight = 3;
+
+  FrameParallelEvaluator evaluator(
+      bmain,
+      scene,
+      BKE_view_layer_default_view(scene),
+      DAG_EVAL_RENDER,
+      [](::Depsgraph *depsgraph) { DEG_graph_build_from_view_layer(depsgraph); },
+      frames,
+      max_frames_in_flight);
+  EXPECT_EQ(evaluator.frames_num(), frames.size());
+
+  Set<::Depsgraph *> depsgraphs;
+  for (const double expected_frame : frames) {
+    double frame = 0.0;
+    ::Depsgraph *depsgraph = evaluator.next_frame(&frame);
+    ASSERT_NE(depsgraph, nullptr);
+    EXPECT_EQ(frame, expected_frame);
+    EXPECT_FLOAT_EQ(DEG_get_ctime(depsgraph), float(expected_frame));
+
+    const Object *object_eval = DEG_get_evaluated_object(depsgraph, object);
+    EXPECT_FLOAT_EQ(object_eval->loc[0], float(expected_frame) - 1.0f);
+    EXPECT_FLOAT_EQ(object_eval->object_to_world[3][0], float(expected_frame) - 1.0f);
+
+    depsgraphs.add(depsgraph);
+  }
+  EXPECT_EQ(evaluator.next_frame(nullptr), nullptr);
+
+  /* Memory is bounded by the number of dependency graphs. */
+  EXPECT_EQ(depsgraphs.size(), max_frames_in_flight);
+
+  /* The original data is not modified. */
+  EXPECT_EQ(object->loc[0], 0.0f);
+}
+
+TEST_F(FrameParallelEvaluatorTest, DestroyBeforeAllFramesConsumed)
+{
+  const Vector<double> frames = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+  FrameParallelEvaluator evaluator(
+      bmain,
+      scene,
+      BKE_view_layer_default_view(scene),
+      DAG_EVAL_RENDER,
+      [](::Depsgraph *depsgraph) { DEG_graph_build_from_view_layer(depsgraph); },
+      frames,
+      2);
+
+  double frame = 0.0;
+  ::Depsgraph *depsgraph = evaluator.next_frame(&frame);
+  ASSERT_NE(depsgraph, nullptr);
+  EXPECT_EQ(frame, 1.0);
+  /* The remaining frames are cancelled when the evaluator is destroyed. */
+}
+
+}  // namespace blender::deg::tests
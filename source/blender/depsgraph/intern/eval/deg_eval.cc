@@ -15,7 +15,10 @@
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
+#include "BLI_heap.h"
+#include "BLI_math_base.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -53,6 +56,7 @@ namespace {
 struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata);
+void deg_task_run_critical_path_func(TaskPool *pool, void *taskdata);
 
 void schedule_children(DepsgraphEvalState *state,
                        OperationNode *node,
@@ -84,8 +88,19 @@ struct DepsgraphEvalState {
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+
+  /* Order ready operations of the threaded evaluation stage by their critical path time instead
+   * of the order in which they became ready. */
+  bool use_critical_path = false;
+  /* Operations which are ready for evaluation, keyed by negative critical path time.
+   * Every task pushed to the pool pops the top of this heap. */
+  Heap *ready_heap = nullptr;
+  SpinLock ready_heap_lock;
 };
 
+/* Weight of the latest evaluation time in the operation's average evaluation time. */
+const float AVERAGE_TIME_WEIGHT = 0.25f;
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
@@ -93,13 +108,21 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double time = PIL_check_seconds_timer() - start_time;
+
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += time;
+  }
+
+  /* Keep history of the evaluation cost, used for scheduling of the next evaluation. */
+  if (operation_node->average_time == 0.0f) {
+    operation_node->average_time = float(time);
   }
   else {
-    operation_node->evaluate(depsgraph);
+    operation_node->average_time = interpf(
+        float(time), operation_node->average_time, AVERAGE_TIME_WEIGHT);
   }
 
   /* Clear the flag early on, allowing partial updates without re-evaluating the same node multiple
@@ -124,6 +147,35 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   });
 }
 
+void schedule_critical_path_node(TaskPool *pool, DepsgraphEvalState *state, OperationNode *node)
+{
+  BLI_spin_lock(&state->ready_heap_lock);
+  BLI_heap_insert(state->ready_heap, -node->critical_path_time, node);
+  BLI_spin_unlock(&state->ready_heap_lock);
+
+  BLI_task_pool_push(pool, deg_task_run_critical_path_func, nullptr, false, nullptr);
+}
+
+void deg_task_run_critical_path_func(TaskPool *pool, void * /*taskdata*/)
+{
+  void *userdata_v = BLI_task_pool_user_data(pool);
+  DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
+
+  /* Evaluate the ready operation with the longest critical path, which is not necessarily the one
+   * this task was pushed for. There is one task pushed per ready operation, so the heap can not be
+   * empty here. */
+  BLI_spin_lock(&state->ready_heap_lock);
+  OperationNode *operation_node = static_cast<OperationNode *>(
+      BLI_heap_pop_min(state->ready_heap));
+  BLI_spin_unlock(&state->ready_heap_lock);
+
+  evaluate_node(state, operation_node);
+
+  schedule_children(state, operation_node, [&](OperationNode *node) {
+    schedule_critical_path_node(pool, state, node);
+  });
+}
+
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
@@ -187,6 +239,59 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
   state->need_update_pending_parents = false;
 }
 
+bool need_evaluate_operation(const DepsgraphEvalState *state, OperationNode *node)
+{
+  return check_operation_node_visible(state, node) && (node->flag & DEPSOP_FLAG_NEEDS_UPDATE);
+}
+
+/* Calculate critical path time of all operations which are to be evaluated, based on the
+ * evaluation time history of the operations.
+ *
+ * Operations are visited in reverse topological order, with the generic traversal counter of the
+ * nodes used to track the number of not yet visited children. */
+void calculate_critical_path_times(DepsgraphEvalState *state)
+{
+  Vector<OperationNode *> queue;
+
+  for (OperationNode *node : state->graph->operations) {
+    node->critical_path_time = 0.0f;
+    node->custom_flags = 0;
+    if (!need_evaluate_operation(state, node)) {
+      continue;
+    }
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && need_evaluate_operation(state, child)) {
+        ++node->custom_flags;
+      }
+    }
+    if (node->custom_flags == 0) {
+      queue.append(node);
+    }
+  }
+
+  while (!queue.is_empty()) {
+    OperationNode *node = queue.pop_last();
+    /* At this point the critical path time holds the maximum of all children. */
+    if (!node->is_noop()) {
+      node->critical_path_time += node->average_time;
+    }
+    for (Relation *rel : node->inlinks) {
+      if (rel->from->type != NodeType::OPERATION || (rel->flag & RELATION_FLAG_CYCLIC) != 0) {
+        continue;
+      }
+      OperationNode *parent = (OperationNode *)rel->from;
+      if (!need_evaluate_operation(state, parent)) {
+        continue;
+      }
+      parent->critical_path_time = max_ff(parent->critical_path_time, node->critical_path_time);
+      if (--parent->custom_flags == 0) {
+        queue.append(parent);
+      }
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   /* Clear tags and other things which needs to be clear. */
@@ -318,6 +423,24 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
+  if (stage == EvaluationStage::THREADED_EVALUATION && state->use_critical_path) {
+    calculate_critical_path_times(state);
+
+    state->ready_heap = BLI_heap_new();
+    BLI_spin_init(&state->ready_heap_lock);
+
+    schedule_graph(state, [&](OperationNode *node) {
+      schedule_critical_path_node(task_pool, state, node);
+    });
+    BLI_task_pool_work_and_wait(task_pool);
+
+    BLI_assert(BLI_heap_is_empty(state->ready_heap));
+    BLI_spin_end(&state->ready_heap_lock);
+    BLI_heap_free(state->ready_heap, nullptr);
+    state->ready_heap = nullptr;
+    return;
+  }
+
   schedule_graph(state, [&](OperationNode *node) {
     BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
   });
@@ -401,6 +524,8 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  /* Prioritization makes no difference when operations are evaluated one by one. */
+  state.use_critical_path = (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) == 0;
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -454,6 +579,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * synchronization. */
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
+    deg_eval_stats_print_schedule_replay(graph);
   }
 
   /* Clear any uncleared tags. */
@@ -18,6 +18,7 @@
 
 #include "intern/eval/deg_eval_copy_on_write.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "BLI_listbase.h"
@@ -899,7 +900,17 @@ ID *deg_update_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_copy_on_write_datablock(id_cow);
-  deg_expand_copy_on_write_datablock(depsgraph, id_node);
+  if (depsgraph->debug.do_time_debug()) {
+    /* The copy happens on the calling thread, so its allocations can be measured with the memory
+     * usage of this thread. Data shared with the original is not counted, as intended. */
+    const int64_t memory_before_copy = MEM_get_thread_memory_in_use();
+    deg_expand_copy_on_write_datablock(depsgraph, id_node);
+    depsgraph->debug.add_copy_on_write_update(
+        std::max<int64_t>(MEM_get_thread_memory_in_use() - memory_before_copy, 0));
+  }
+  else {
+    deg_expand_copy_on_write_datablock(depsgraph, id_node);
+  }
   backup.restore_to_id(id_cow);
   return id_cow;
 }
@@ -8,9 +8,15 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <cstdio>
+
+#include "BLI_heap.h"
+#include "BLI_math_base.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -39,4 +45,149 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+static bool is_replay_relation(const Relation *rel)
+{
+  return rel->from->type == NodeType::OPERATION && rel->to->type == NodeType::OPERATION &&
+         (rel->flag & RELATION_FLAG_CYCLIC) == 0;
+}
+
+/* Critical path time of every operation for the recorded timings, indexed by operation index.
+ * Operations which were not evaluated have zero time and only pass dependencies through. */
+static Vector<float> replay_critical_path_times(const Depsgraph *graph,
+                                                const Map<const OperationNode *, int> &indices)
+{
+  const int num_operations = graph->operations.size();
+  Vector<float> critical_path_times(num_operations, 0.0f);
+  Vector<int> num_pending_children(num_operations, 0);
+  Vector<const OperationNode *> queue;
+
+  for (const int i : graph->operations.index_range()) {
+    const OperationNode *node = graph->operations[i];
+    for (const Relation *rel : node->outlinks) {
+      if (is_replay_relation(rel)) {
+        num_pending_children[i]++;
+      }
+    }
+    if (num_pending_children[i] == 0) {
+      queue.append(node);
+    }
+  }
+
+  while (!queue.is_empty()) {
+    const OperationNode *node = queue.pop_last();
+    const int index = indices.lookup(node);
+    critical_path_times[index] += node->stats.current_time;
+    for (const Relation *rel : node->inlinks) {
+      if (!is_replay_relation(rel)) {
+        continue;
+      }
+      const int parent_index = indices.lookup(static_cast<const OperationNode *>(rel->from));
+      critical_path_times[parent_index] = max_ff(critical_path_times[parent_index],
+                                                 critical_path_times[index]);
+      if (--num_pending_children[parent_index] == 0) {
+        queue.append(static_cast<const OperationNode *>(rel->from));
+      }
+    }
+  }
+
+  return critical_path_times;
+}
+
+double deg_eval_stats_replay_schedule(const Depsgraph *graph,
+                                      const int num_threads,
+                                      const bool use_critical_path)
+{
+  const int num_operations = graph->operations.size();
+
+  Map<const OperationNode *, int> indices;
+  indices.reserve(num_operations);
+  for (const int i : graph->operations.index_range()) {
+    indices.add_new(graph->operations[i], i);
+  }
+
+  Vector<float> critical_path_times;
+  if (use_critical_path) {
+    critical_path_times = replay_critical_path_times(graph, indices);
+  }
+
+  Vector<int> num_pending_parents(num_operations, 0);
+  for (const OperationNode *node : graph->operations) {
+    for (const Relation *rel : node->outlinks) {
+      if (is_replay_relation(rel)) {
+        num_pending_parents[indices.lookup(static_cast<const OperationNode *>(rel->to))]++;
+      }
+    }
+  }
+
+  /* Operations which are ready for evaluation, and operations which are being evaluated keyed by
+   * the time their evaluation finishes. Without critical path the ready operations are taken in
+   * the order they became ready, same as the task pool does. */
+  Heap *ready_heap = BLI_heap_new();
+  Heap *running_heap = BLI_heap_new();
+  float ready_order = 0.0f;
+
+  auto push_ready = [&](const OperationNode *node) {
+    const int index = indices.lookup(node);
+    const float value = use_critical_path ? -critical_path_times[index] : ready_order++;
+    BLI_heap_insert(ready_heap, value, const_cast<OperationNode *>(node));
+  };
+  auto finish = [&](const OperationNode *node) {
+    for (const Relation *rel : node->outlinks) {
+      if (!is_replay_relation(rel)) {
+        continue;
+      }
+      const OperationNode *child = static_cast<const OperationNode *>(rel->to);
+      if (--num_pending_parents[indices.lookup(child)] == 0) {
+        push_ready(child);
+      }
+    }
+  };
+
+  for (const int i : graph->operations.index_range()) {
+    if (num_pending_parents[i] == 0) {
+      push_ready(graph->operations[i]);
+    }
+  }
+
+  double time = 0.0;
+  int num_free_threads = max_ii(num_threads, 1);
+  while (true) {
+    while (num_free_threads != 0 && !BLI_heap_is_empty(ready_heap)) {
+      const OperationNode *node = static_cast<const OperationNode *>(
+          BLI_heap_pop_min(ready_heap));
+      if (node->stats.current_time == 0.0) {
+        /* Not evaluated or no-op, does not occupy a thread. */
+        finish(node);
+        continue;
+      }
+      BLI_heap_insert(
+          running_heap, float(time + node->stats.current_time), const_cast<OperationNode *>(node));
+      num_free_threads--;
+    }
+    if (BLI_heap_is_empty(running_heap)) {
+      break;
+    }
+    time = BLI_heap_top_value(running_heap);
+    const OperationNode *node = static_cast<const OperationNode *>(
+        BLI_heap_pop_min(running_heap));
+    num_free_threads++;
+    finish(node);
+  }
+
+  BLI_heap_free(ready_heap, nullptr);
+  BLI_heap_free(running_heap, nullptr);
+
+  return time;
+}
+
+void deg_eval_stats_print_schedule_replay(const Depsgraph *graph)
+{
+  const int num_threads = BLI_system_thread_count();
+  printf("Depsgraph schedule replay on %d threads: %f seconds in ready order, %f seconds in "
+         "critical path order.\n",
+         num_threads,
+         deg_eval_stats_replay_schedule(graph, num_threads, false),
+         deg_eval_stats_replay_schedule(graph, num_threads, true));
+}
+
 }  // namespace blender::deg
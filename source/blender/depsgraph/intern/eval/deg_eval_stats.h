@@ -15,4 +15,16 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Replay the last graph evaluation with the timings recorded for its operations, simulating the
+ * scheduling of the operations on the given number of threads without evaluating anything.
+ *
+ * Returns the time the evaluation would have taken. Only valid when time debug was enabled for
+ * the last evaluation. */
+double deg_eval_stats_replay_schedule(const Depsgraph *graph,
+                                      int num_threads,
+                                      bool use_critical_path);
+
+/* Print replayed evaluation time of the scheduling policies for the last graph evaluation. */
+void deg_eval_stats_print_schedule_replay(const Depsgraph *graph);
+
 }  // namespace blender::deg
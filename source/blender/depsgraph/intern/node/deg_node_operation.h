@@ -285,6 +285,15 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Exponential moving average of the evaluation time of this operation, in seconds.
+   * Is updated on every evaluation, regardless of whether time debug is enabled. */
+  float average_time;
+
+  /* Estimated time in seconds from the beginning of evaluation of this operation until all
+   * operations which depend on it are evaluated. Used by the evaluation engine to start the
+   * operations on the critical path of the graph first. */
+  float critical_path_time;
+
   DEG_DEPSNODE_DECLARE;
 };
 
@@ -124,6 +124,7 @@ static int wm_alembic_export_exec(bContext *C, wmOperator *op)
   params.quad_method = RNA_enum_get(op->ptr, "quad_method");
   params.ngon_method = RNA_enum_get(op->ptr, "ngon_method");
   params.evaluation_mode = eEvaluationMode(RNA_enum_get(op->ptr, "evaluation_mode"));
+  params.parallel_frames = RNA_int_get(op->ptr, "parallel_frames");
 
   params.global_scale = RNA_float_get(op->ptr, "global_scale");
 
@@ -184,6 +185,7 @@ static void ui_alembic_export_settings(uiLayout *layout, PointerRNA *imfptr)
 
   col = uiLayoutColumn(box, true);
   uiItemR(col, imfptr, "evaluation_mode", 0, nullptr, ICON_NONE);
+  uiItemR(col, imfptr, "parallel_frames", 0, nullptr, ICON_NONE);
 
   /* Object Data */
   box = uiLayoutBox(layout);
@@ -462,6 +464,18 @@ void WM_OT_alembic_export(wmOperatorType *ot)
                "Determines visibility of objects, modifier settings, and other areas where there "
                "are different settings for viewport and rendering");
 
+  RNA_def_int(ot->srna,
+              "parallel_frames",
+              1,
+              1,
+              16,
+              "Parallel Frames",
+              "Number of frames evaluated at the same time, each on its own copy of the scene. "
+              "Only use when frames do not depend on previous frames, as simulations, frame "
+              "change handlers and image sequences are not updated for the parallel frames",
+              1,
+              16);
+
   /* This dummy prop is used to check whether we need to init the start and
    * end frame values to that of the scene's, otherwise they are reset at
    * every change, draw update. */
@@ -106,6 +106,10 @@ struct BakeAPIRender {
   /* Baking render session. */
   Render *render;
 
+  /* Depsgraph shared by all objects baked by the job, so that the render engine is kept and the
+   * scene is only synchronized once. Null when every object is baked with its own depsgraph. */
+  Depsgraph *depsgraph;
+
   /* Progress Callbacks. */
   float *progress;
   bool *do_update;
@@ -1402,8 +1406,11 @@ static int bake(const BakeAPIRender *bkr,
 
   /* We build a depsgraph for the baking,
    * so we don't need to change the original data to adjust visibility and modifiers. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_graph_build_from_view_layer(depsgraph);
+  Depsgraph *depsgraph = bkr->depsgraph;
+  if (depsgraph == nullptr) {
+    depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+    DEG_graph_build_from_view_layer(depsgraph);
+  }
 
   int op_result = OPERATOR_CANCELLED;
   bool ok = false;
@@ -1634,7 +1641,8 @@ static int bake(const BakeAPIRender *bkr,
                           &targets,
                           bkr->pass_type,
                           bkr->pass_filter,
-                          targets.result);
+                          targets.result,
+                          false);
       if (!ok) {
         BKE_reportf(
             reports, RPT_ERROR, "Error baking from object \"%s\"", highpoly[i].ob->id.name + 2);
@@ -1655,7 +1663,8 @@ static int bake(const BakeAPIRender *bkr,
                           &targets,
                           bkr->pass_type,
                           bkr->pass_filter,
-                          targets.result);
+                          targets.result,
+                          bkr->depsgraph != nullptr);
     }
     else {
       BKE_report(reports, RPT_ERROR, "Current render engine does not support baking");
@@ -1788,11 +1797,51 @@ cleanup:
     BKE_id_free(nullptr, &me_cage_eval->id);
   }
 
-  DEG_graph_free(depsgraph);
+  if (depsgraph != bkr->depsgraph) {
+    DEG_graph_free(depsgraph);
+  }
 
   return op_result;
 }
 
+/* Multiple objects baked by one job can share the depsgraph and render engine, which avoids
+ * synchronizing the scene and building acceleration structures for every object. This is not
+ * possible when modifier settings are changed per object before evaluation, as is done for
+ * multi-resolution tangent space normals. Selected to active baking uses a single bake. */
+static bool bake_use_shared_depsgraph(const BakeAPIRender *bkr)
+{
+  if (bkr->is_selected_to_active) {
+    return false;
+  }
+
+  if (bkr->pass_type == SCE_PASS_NORMAL && bkr->normal_space == R_BAKE_SPACE_TANGENT) {
+    return false;
+  }
+
+  return BLI_listbase_count_at_most(&bkr->selected_objects, 2) > 1;
+}
+
+static void bake_shared_depsgraph_begin(BakeAPIRender *bkr)
+{
+  if (!bake_use_shared_depsgraph(bkr)) {
+    return;
+  }
+
+  bkr->depsgraph = DEG_graph_new(bkr->main, bkr->scene, bkr->view_layer, DAG_EVAL_RENDER);
+  DEG_graph_build_from_view_layer(bkr->depsgraph);
+}
+
+static void bake_shared_depsgraph_end(BakeAPIRender *bkr)
+{
+  if (bkr->depsgraph == nullptr) {
+    return;
+  }
+
+  RE_bake_engine_free(bkr->render);
+  DEG_graph_free(bkr->depsgraph);
+  bkr->depsgraph = nullptr;
+}
+
 /* Bake Operator */
 
 static void bake_init_api_data(wmOperator *op, bContext *C, BakeAPIRender *bkr)
@@ -1848,6 +1897,7 @@ static void bake_init_api_data(wmOperator *op, bContext *C, BakeAPIRender *bkr)
   bkr->result = OPERATOR_CANCELLED;
 
   bkr->render = RE_NewSceneRender(bkr->scene);
+  bkr->depsgraph = nullptr;
 
   /* XXX hack to force saving to always be internal. Whether (and how) to support
    * external saving will be addressed later */
@@ -1910,12 +1960,14 @@ static int bake_exec(bContext *C, wmOperator *op)
   else {
     CollectionPointerLink *link;
     bkr.is_clear = bkr.is_clear && BLI_listbase_is_single(&bkr.selected_objects);
+    bake_shared_depsgraph_begin(&bkr);
     for (link = static_cast<CollectionPointerLink *>(bkr.selected_objects.first); link;
          link = link->next)
     {
       Object *ob_iter = static_cast<Object *>(link->ptr.data);
       result = bake(&bkr, ob_iter, nullptr, bkr.reports);
     }
+    bake_shared_depsgraph_end(&bkr);
   }
 
   RE_SetReports(re, nullptr);
@@ -1966,6 +2018,7 @@ static void bake_startjob(void *bkv, bool * /*stop*/, bool *do_update, float *pr
   else {
     CollectionPointerLink *link;
     bkr->is_clear = bkr->is_clear && BLI_listbase_is_single(&bkr->selected_objects);
+    bake_shared_depsgraph_begin(bkr);
     for (link = static_cast<CollectionPointerLink *>(bkr->selected_objects.first); link;
          link = link->next)
     {
@@ -1973,9 +2026,11 @@ static void bake_startjob(void *bkv, bool * /*stop*/, bool *do_update, float *pr
       bkr->result = bake(bkr, ob_iter, nullptr, bkr->reports);
 
       if (bkr->result == OPERATOR_CANCELLED) {
+        bake_shared_depsgraph_end(bkr);
         return;
       }
     }
+    bake_shared_depsgraph_end(bkr);
   }
 
   RE_SetReports(bkr->render, nullptr);
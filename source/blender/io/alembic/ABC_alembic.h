@@ -54,6 +54,10 @@ struct AlembicExportParams {
   bool use_instancing;
   enum eEvaluationMode evaluation_mode;
 
+  /* Number of frames evaluated at the same time on separate dependency graphs. Frames are
+   * evaluated one after the other on the export dependency graph when this is 1 or less. */
+  int parallel_frames;
+
   /* See MOD_TRIANGULATE_NGON_xxx and MOD_TRIANGULATE_QUAD_xxx
    * in DNA_modifier_types.h */
   int quad_method;
@@ -11,6 +11,7 @@
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
+#include "DEG_depsgraph_frame_parallel.hh"
 #include "DEG_depsgraph_query.h"
 
 #include "DNA_modifier_types.h"
@@ -26,6 +27,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "WM_api.h"
 #include "WM_types.h"
@@ -70,6 +72,48 @@ static void report_job_duration(const ExportJobData *data)
   std::cout << '\n';
 }
 
+/* Export the animated frames from dependency graphs that are evaluated several frames at a time,
+ * instead of evaluating the frames one after the other on the export dependency graph. */
+static void export_frames_parallel(ExportJobData *data,
+                                   ABCArchive *abc_archive,
+                                   ABCHierarchyIterator &iter,
+                                   const bool *stop,
+                                   bool *do_update,
+                                   float *progress,
+                                   const float progress_per_frame)
+{
+  const Vector<double> frames(abc_archive->frames_begin(), abc_archive->frames_end());
+  const bool visible_objects_only = data->params.visible_objects_only;
+
+  deg::FrameParallelEvaluator evaluator(
+      data->bmain,
+      DEG_get_input_scene(data->depsgraph),
+      DEG_get_input_view_layer(data->depsgraph),
+      DEG_get_mode(data->depsgraph),
+      [&](Depsgraph *depsgraph) { build_depsgraph(depsgraph, visible_objects_only); },
+      frames,
+      data->params.parallel_frames);
+
+  double frame;
+  while (Depsgraph *frame_depsgraph = evaluator.next_frame(&frame)) {
+    if (G.is_break || (stop != nullptr && *stop)) {
+      break;
+    }
+
+    CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
+    iter.set_depsgraph(frame_depsgraph);
+    ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
+    iter.set_export_subset(export_subset);
+    iter.iterate_and_write();
+
+    *progress += progress_per_frame;
+    *do_update = true;
+  }
+
+  /* The dependency graphs of the evaluator are freed along with it. */
+  iter.set_depsgraph(data->depsgraph);
+}
+
 static void export_startjob(void *customdata,
                             /* Cannot be const, this function implements wm_jobs_start_callback.
                              * NOLINTNEXTLINE: readability-non-const-parameter. */
@@ -134,28 +178,35 @@ static void export_startjob(void *customdata,
 
     /* Writing the animated frames is not 100% of the work, but it's our best guess. */
     const float progress_per_frame = 1.0f / std::max(size_t(1), abc_archive->total_frame_count());
-    ABCArchive::Frames::const_iterator frame_it = abc_archive->frames_begin();
-    const ABCArchive::Frames::const_iterator frames_end = abc_archive->frames_end();
 
-    for (; frame_it != frames_end; frame_it++) {
-      double frame = *frame_it;
+    if (data->params.parallel_frames > 1) {
+      export_frames_parallel(
+          data, abc_archive.get(), iter, stop, do_update, progress, progress_per_frame);
+    }
+    else {
+      ABCArchive::Frames::const_iterator frame_it = abc_archive->frames_begin();
+      const ABCArchive::Frames::const_iterator frames_end = abc_archive->frames_end();
+
+      for (; frame_it != frames_end; frame_it++) {
+        double frame = *frame_it;
 
-      if (G.is_break || (stop != nullptr && *stop)) {
-        break;
-      }
+        if (G.is_break || (stop != nullptr && *stop)) {
+          break;
+        }
 
-      /* Update the scene for the next frame to render. */
-      scene->r.cfra = int(frame);
-      scene->r.subframe = float(frame - scene->r.cfra);
-      BKE_scene_graph_update_for_newframe(data->depsgraph);
+        /* Update the scene for the next frame to render. */
+        scene->r.cfra = int(frame);
+        scene->r.subframe = float(frame - scene->r.cfra);
+        BKE_scene_graph_update_for_newframe(data->depsgraph);
 
-      CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
-      ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
-      iter.set_export_subset(export_subset);
-      iter.iterate_and_write();
+        CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
+        ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
+        iter.set_export_subset(export_subset);
+        iter.iterate_and_write();
 
-      *progress += progress_per_frame;
-      *do_update = true;
+        *progress += progress_per_frame;
+        *do_update = true;
+      }
     }
   }
   else {
@@ -23,11 +23,11 @@ class ABCAbstractWriter;
 class ABCHierarchyIterator;
 
 struct ABCWriterConstructorArgs {
-  Depsgraph *depsgraph;
   ABCArchive *abc_archive;
   Alembic::Abc::OObject abc_parent;
   std::string abc_name;
   std::string abc_path;
+  /* Provides the dependency graph of the frame being written, which can change between frames. */
   const ABCHierarchyIterator *hierarchy_iterator;
   const AlembicExportParams *export_params;
 };
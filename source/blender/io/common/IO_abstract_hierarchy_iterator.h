@@ -231,6 +231,12 @@ class AbstractHierarchyIterator {
    * previous iteration. */
   void set_export_subset(ExportSubset export_subset);
 
+  /* Continue iterating over another dependency graph, built for the same scene and view layer
+   * but evaluated for a different frame. The writers are kept, so that the following calls to
+   * iterate_and_write() add to the data written so far. */
+  void set_depsgraph(Depsgraph *depsgraph);
+  Depsgraph *get_depsgraph() const;
+
   /* Convert the given name to something that is valid for the exported file format.
    * This base implementation is a no-op; override in a concrete subclass. */
   virtual std::string make_valid_name(const std::string &name) const;
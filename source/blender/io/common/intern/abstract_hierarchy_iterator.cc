@@ -197,6 +197,18 @@ void AbstractHierarchyIterator::set_export_subset(ExportSubset export_subset)
   export_subset_ = export_subset;
 }
 
+void AbstractHierarchyIterator::set_depsgraph(Depsgraph *depsgraph)
+{
+  depsgraph_ = depsgraph;
+  /* The export paths are looked up by evaluated ID, which differ between dependency graphs. */
+  duplisource_export_path_.clear();
+}
+
+Depsgraph *AbstractHierarchyIterator::get_depsgraph() const
+{
+  return depsgraph_;
+}
+
 std::string AbstractHierarchyIterator::make_valid_name(const std::string &name) const
 {
   return name;
@@ -646,6 +646,13 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe that ended the segment used by the last evaluation. Runtime only, used
+   * to skip the keyframe look-up when the evaluation time did not move to another segment.
+   */
+  int eval_segment_hint;
+  char _pad1[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -15,6 +15,16 @@
 #include "DNA_defs.h"
 #include "DNA_listBase.h"
 
+/** Workaround to forward-declare C++ type in C header. */
+#ifdef __cplusplus
+namespace blender::bke {
+struct KeyRuntime;
+}  // namespace blender::bke
+using KeyRuntimeHandle = blender::bke::KeyRuntime;
+#else
+typedef struct KeyRuntimeHandle KeyRuntimeHandle;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -104,6 +114,12 @@ typedef struct Key {
    * current free UID for key-blocks.
    */
   int uidgen;
+
+  /**
+   * Data that isn't saved in files, such as caches used for the evaluation of the copy-on-write
+   * key. Only allocated when needed, may be null.
+   */
+  KeyRuntimeHandle *runtime;
 } Key;
 
 /* **************** KEY ********************* */
@@ -191,6 +191,7 @@ static void rna_Mesh_update(Mesh *mesh,
 
   mesh->runtime->vert_normals_dirty = true;
   mesh->runtime->poly_normals_dirty = true;
+  mesh->runtime->normals_dirty_verts.clear_and_shrink();
 
   DEG_id_tag_update(&mesh->id, 0);
   WM_event_add_notifier(C, NC_GEOM | ND_DATA, mesh);
@@ -50,6 +50,27 @@ static void set_computed_position_and_offset(GeometryComponent &component,
   const GrainSize grain_size{10000};
 
   switch (component.type()) {
+    case GeometryComponent::Type::Mesh: {
+      Mesh &mesh = *static_cast<MeshComponent &>(component).get_for_write();
+      MutableSpan<float3> out_positions_span = mesh.vert_positions_for_write();
+      if (positions_are_original) {
+        devirtualize_varray(in_offsets, [&](const auto in_offsets) {
+          selection.foreach_index_optimized<int>(
+              grain_size, [&](const int i) { out_positions_span[i] += in_offsets[i]; });
+        });
+      }
+      else {
+        devirtualize_varray2(
+            in_positions, in_offsets, [&](const auto in_positions, const auto in_offsets) {
+              selection.foreach_index_optimized<int>(grain_size, [&](const int i) {
+                out_positions_span[i] = in_positions[i] + in_offsets[i];
+              });
+            });
+      }
+      /* Normals which were already computed only have to be updated around the selection. */
+      bke::mesh::tag_positions_changed_partial(mesh, selection);
+      break;
+    }
     case GeometryComponent::Type::Curve: {
       if (attributes.contains("handle_right") && attributes.contains("handle_left")) {
         CurveComponent &curve_component = static_cast<CurveComponent &>(component);
@@ -79,7 +79,13 @@ bool RE_bake_engine(struct Render *re,
                     const BakeTargets *targets,
                     eScenePassType pass_type,
                     int pass_filter,
-                    float result[]);
+                    float result[],
+                    bool keep_engine);
+
+/**
+ * Free the engine kept by #RE_bake_engine, once all objects sharing it have been baked.
+ */
+void RE_bake_engine_free(struct Render *re);
 
 /* bake.c */
 
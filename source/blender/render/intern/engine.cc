@@ -825,7 +825,8 @@ bool RE_bake_engine(Render *re,
                     const BakeTargets *targets,
                     const eScenePassType pass_type,
                     const int pass_filter,
-                    float result[])
+                    float result[],
+                    const bool keep_engine)
 {
   RenderEngineType *type = RE_engines_find(re->r.engine);
   RenderEngine *engine;
@@ -837,7 +838,8 @@ bool RE_bake_engine(Render *re,
   /* render */
   engine = re->engine;
 
-  if (!engine) {
+  const bool is_new_engine = (engine == nullptr);
+  if (is_new_engine) {
     engine = RE_engine_create(type);
     re->engine = engine;
   }
@@ -853,8 +855,9 @@ bool RE_bake_engine(Render *re,
   if (type->bake) {
     engine->depsgraph = depsgraph;
 
-    /* update is only called so we create the engine.session */
-    if (type->update) {
+    /* update is only called so we create the engine.session, a kept engine already has its
+     * session with the scene of the shared depsgraph. */
+    if (type->update && is_new_engine) {
       type->update(engine, re->main, engine->depsgraph);
     }
 
@@ -885,10 +888,9 @@ bool RE_bake_engine(Render *re,
 
   engine->flag &= ~RE_ENGINE_RENDERING;
 
-  engine_depsgraph_free(engine);
-
-  RE_engine_free(engine);
-  re->engine = nullptr;
+  if (!keep_engine) {
+    RE_bake_engine_free(re);
+  }
 
   if (BKE_reports_contain(re->reports, RPT_ERROR)) {
     G.is_break = true;
@@ -897,6 +899,19 @@ bool RE_bake_engine(Render *re,
   return true;
 }
 
+void RE_bake_engine_free(Render *re)
+{
+  RenderEngine *engine = re->engine;
+  if (engine == nullptr) {
+    return;
+  }
+
+  engine_depsgraph_free(engine);
+
+  RE_engine_free(engine);
+  re->engine = nullptr;
+}
+
 /* Render */
 
 static void engine_render_view_layer(Render *re,